@@ -175,10 +175,15 @@ void FileSyncDialog::setupUi()
   AutoBitsetCheckBox * testRun = new AutoBitsetCheckBox(m_syncOptions.flags, SyncProcess::OPT_DRY_RUN, tr("Test-run only"), this);
   testRun->setToolTip(tr("Run as normal but do not actually copy anything. Useful for verifying results before real sync."));
 
+  AutoBitsetCheckBox * nativeImages = new AutoBitsetCheckBox(m_syncOptions.flags, SyncProcess::OPT_NATIVE_IMAGES, tr("Convert images"), this);
+  nativeImages->setToolTip(tr("Also write a pre-decoded copy of PNG/JPEG images copied to %1 (the radio SD card).\n" \
+                              "Color LCD radios load these much faster than the original images.").arg(m_folderNameB));
+
   // layout to hold size spinbox and checkbox option(s)
   QHBoxLayout * hlay1 = new QHBoxLayout();
   hlay1->addWidget(maxSize, 1);
   hlay1->addWidget(testRun);
+  hlay1->addWidget(nativeImages);
   hlay1->addWidget(new QLabel(tr("Log Level:"), this));
   hlay1->addWidget(logLevel);
 
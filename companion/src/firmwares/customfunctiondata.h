@@ -72,6 +72,7 @@ enum AssignFunc {
   FuncRacingMode,
   FuncDisableTouch,
   FuncSetScreen,
+  FuncScreenRecord,
   FuncCount,
   FuncReserve = -1
 };
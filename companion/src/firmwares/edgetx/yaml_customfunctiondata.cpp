@@ -66,6 +66,7 @@ static const YamlLookupTable customFnLut = {
   {  FuncRacingMode, "RACING_MODE"  },
   {  FuncDisableTouch, "DISABLE_TOUCH"  },
   {  FuncSetScreen, "SET_SCREEN"},
+  {  FuncScreenRecord, "SCREEN_RECORD"  },
 };
 
 static const YamlLookupTable trainerLut = {
@@ -212,6 +212,7 @@ Node convert<GeneralSettings>::encode(const GeneralSettings& rhs)
   node["disableRtcWarning"] = (int)rhs.rtcCheckDisable;  // TODO: verify
   node["audioMuteEnable"] = (int)rhs.muteIfNoSound;
   node["keysBacklight"] = (int)rhs.keysBacklight;
+  node["mixerDeferOnOverrun"] = (int)rhs.mixerDeferOnOverrun;
   node["rotEncMode"] = (int)rhs.rotEncMode;
   node["imperial"] = rhs.imperial;
   node["ttsLanguage"] = rhs.ttsLanguage;
@@ -431,6 +432,7 @@ bool convert<GeneralSettings>::decode(const Node& node, GeneralSettings& rhs)
   node["disableRtcWarning"] >> rhs.rtcCheckDisable;  // TODO: verify
   node["audioMuteEnable"] >> rhs.muteIfNoSound;
   node["keysBacklight"] >> rhs.keysBacklight;
+  node["mixerDeferOnOverrun"] >> rhs.mixerDeferOnOverrun;
   node["rotEncDirection"] >> rhs.rotEncMode;    // PR2045: read old name and
   node["rotEncMode"] >> rhs.rotEncMode;         // new, but don't write old
   node["imperial"] >> rhs.imperial;
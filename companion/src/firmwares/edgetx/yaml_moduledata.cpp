@@ -239,6 +239,7 @@ Node convert<ModuleData>::encode(const ModuleData& rhs)
         Node crsf;
         YamlTelemetryBaudrate br(&rhs.crsf.telemetryBaudrate);
         crsf["telemetryBaudrate"] = br.value;
+        crsf["subsetChannels"] = (int)rhs.crsf.subsetChannels;
         mod["crsf"] = crsf;
     } break;
     case PULSES_LEMON_DSMP: {
@@ -377,6 +378,7 @@ bool convert<ModuleData>::decode(const Node& node, ModuleData& rhs)
           YamlTelemetryBaudrate telemetryBaudrate;
           crsf["telemetryBaudrate"] >> telemetryBaudrate.value;
           telemetryBaudrate.toCpn(&rhs.crsf.telemetryBaudrate, getCurrentFirmware()->getBoard());
+          crsf["subsetChannels"] >> rhs.crsf.subsetChannels;
       } else if (mod["dsmp"]) {
           Node dsmp = mod["dsmp"];
           dsmp["flags"] >> rhs.dsmp.flags;
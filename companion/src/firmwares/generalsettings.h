@@ -249,6 +249,7 @@ class GeneralSettings {
     bool rtcCheckDisable;
     bool muteIfNoSound;
     bool keysBacklight;
+    bool mixerDeferOnOverrun;
     unsigned int rotEncMode;
     unsigned int imperial;
     char ttsLanguage[TTS_LANGUAGE_LEN + 1];
@@ -160,6 +160,7 @@ class ModuleData {
 
     struct CRSF {
       unsigned int telemetryBaudrate;
+      bool subsetChannels;
     } crsf;
 
     struct Access {
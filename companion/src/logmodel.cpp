@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "logmodel.h"
+
+#include <algorithm>
+#include <ctype.h>
+#include <string.h>
+
+LogModel::LogModel(QObject * parent) :
+  QAbstractTableModel(parent),
+  m_map(nullptr),
+  m_data(nullptr)
+{
+}
+
+LogModel::~LogModel()
+{
+  release();
+}
+
+void LogModel::release()
+{
+  if (m_map) {
+    m_file.unmap(m_map);
+    m_map = nullptr;
+  }
+  if (m_file.isOpen())
+    m_file.close();
+  m_buffer.clear();
+  m_data = nullptr;
+  m_offsets.clear();
+  m_lengths.clear();
+  m_times.clear();
+  m_header.clear();
+  m_columns.clear();
+}
+
+void LogModel::clear()
+{
+  beginResetModel();
+  release();
+  endResetModel();
+}
+
+bool LogModel::load(const QString & filename, int * errors, int * lines)
+{
+  int errorCount = 0;
+  int lineCount = -1;
+
+  beginResetModel();
+  release();
+
+  m_file.setFileName(filename);
+  if (m_file.open(QIODevice::ReadOnly)) {
+    qint64 size = m_file.size();
+    m_map = size > 0 ? m_file.map(0, size) : nullptr;
+    if (m_map) {
+      m_data = (const char *)m_map;
+    }
+    else {
+      m_buffer = m_file.readAll();
+      m_data = m_buffer.constData();
+      size = m_buffer.size();
+    }
+
+    const char * end = m_data + size;
+    int numfields = -1;
+    for (const char * p = m_data; p < end; lineCount++) {
+      const char * eol = (const char *)memchr(p, '\n', end - p);
+      if (!eol)
+        eol = end;
+
+      // same as QString::trimmed()
+      const char * s = p;
+      const char * e = eol;
+      while (s < e && isspace((unsigned char)*s))
+        s++;
+      while (e > s && isspace((unsigned char)e[-1]))
+        e--;
+      p = eol + 1;
+
+      const int fields = 1 + std::count(s, e, ',');
+      if (numfields == -1) {
+        if (e - s < 9 || strncmp(s, "Date,Time", 9) != 0)
+          break;
+        numfields = fields;
+        m_header = QString::fromUtf8(s, e - s).split(',');
+      }
+      else if (fields == numfields) {
+        m_offsets.append(s - m_data);
+        m_lengths.append(e - s);
+        m_times.append(parseTime(s, e - s));
+      }
+      else {
+        errorCount++;
+      }
+    }
+  }
+
+  if (m_offsets.isEmpty())
+    release();
+  else
+    m_columns.resize(m_header.size());
+
+  endResetModel();
+
+  if (errors)
+    *errors = errorCount;
+  if (lines)
+    *lines = lineCount;
+
+  return !m_offsets.isEmpty();
+}
+
+// "yyyy-MM-dd,HH:mm:ss[.zzz]"
+double LogModel::parseTime(const char * str, int length)
+{
+  int values[7] = { 0, 0, 0, 0, 0, 0, 0 };
+  int field = 0;
+  int digits = 0;
+  for (int i = 0; i < length && field < 7; i++) {
+    const char c = str[i];
+    if (c >= '0' && c <= '9') {
+      if (field == 6 && digits >= 3)
+        continue;
+      values[field] = values[field] * 10 + (c - '0');
+      digits++;
+    }
+    else if (c == ',' && field >= 5) {
+      break;
+    }
+    else {
+      field++;
+      digits = 0;
+    }
+  }
+  // milliseconds may have less than 3 digits
+  if (field == 6) {
+    for (; digits > 0 && digits < 3; digits++)
+      values[6] *= 10;
+  }
+
+  // the local time conversion is by far the slowest part, so only do it
+  // once per hour (DST changes happen on hour boundaries)
+  static int cachedHour[4] = { -1, -1, -1, -1 };
+  static double cachedTime = 0;
+  if (values[0] != cachedHour[0] || values[1] != cachedHour[1] || values[2] != cachedHour[2] || values[3] != cachedHour[3]) {
+    const QDateTime dt(QDate(values[0], values[1], values[2]), QTime(values[3], 0));
+    if (!dt.isValid())
+      return 0;
+    cachedTime = dt.toMSecsSinceEpoch() / 1000;
+    std::copy(values, values + 4, cachedHour);
+  }
+
+  return cachedTime + values[4] * 60 + values[5] + values[6] / 1000.0;
+}
+
+int LogModel::rowCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : m_offsets.size();
+}
+
+int LogModel::columnCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : m_header.size();
+}
+
+QVariant LogModel::data(const QModelIndex & index, int role) const
+{
+  if (!index.isValid() || role != Qt::DisplayRole)
+    return QVariant();
+
+  return field(index.row(), index.column());
+}
+
+QVariant LogModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (role == Qt::DisplayRole) {
+    if (orientation == Qt::Horizontal)
+      return m_header.value(section);
+    return section + 1;
+  }
+  return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+bool LogModel::findField(int row, int column, const char ** start, int * length) const
+{
+  if (row < 0 || row >= m_offsets.size() || column < 0 || column >= m_header.size())
+    return false;
+
+  const char * s = lineData(row);
+  const char * end = s + m_lengths.at(row);
+  for (int i = 0; i < column; i++) {
+    s = (const char *)memchr(s, ',', end - s);
+    if (!s)
+      return false;
+    s++;
+  }
+  const char * e = (const char *)memchr(s, ',', end - s);
+  *start = s;
+  *length = (e ? e : end) - s;
+  return true;
+}
+
+QString LogModel::field(int row, int column) const
+{
+  const char * start;
+  int length;
+  if (!findField(row, column, &start, &length))
+    return QString();
+  return QString::fromUtf8(start, length);
+}
+
+QStringList LogModel::record(int row) const
+{
+  return QString::fromUtf8(line(row)).split(',');
+}
+
+QByteArray LogModel::line(int row) const
+{
+  if (row < 0 || row >= m_offsets.size())
+    return QByteArray();
+  return QByteArray(lineData(row), m_lengths.at(row));
+}
+
+QDateTime LogModel::timestamp(int row) const
+{
+  return QDateTime::fromMSecsSinceEpoch(qRound64(time(row) * 1000));
+}
+
+const QVector<double> & LogModel::values(int column)
+{
+  QVector<double> & values = m_columns[column];
+  if (values.isEmpty()) {
+    const int count = m_offsets.size();
+    values.resize(count);
+    for (int row = 0; row < count; row++) {
+      const char * start;
+      int length;
+      values[row] = findField(row, column, &start, &length) ? QByteArray::fromRawData(start, length).toDouble() : 0;
+    }
+  }
+  return values;
+}
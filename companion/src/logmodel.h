@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QDateTime>
+#include <QFile>
+#include <QStringList>
+#include <QVector>
+
+// Read-only table model over a radio telemetry log (CSV).
+//
+// The file is memory mapped (or read in one block if mapping fails) and only
+// the line boundaries and time stamps are extracted while loading. Cell texts
+// are split on demand for the visible cells, and a column is converted to
+// numbers the first time it is plotted, then kept in that form.
+class LogModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+  public:
+    explicit LogModel(QObject * parent = nullptr);
+    virtual ~LogModel();
+
+    // returns false if the file cannot be read or is not a log file
+    bool load(const QString & filename, int * errors = nullptr, int * lines = nullptr);
+    void clear();
+
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    const QStringList & header() const { return m_header; }
+    QStringList record(int row) const;
+    QString field(int row, int column) const;
+    QByteArray line(int row) const;
+
+    // record time, in seconds since epoch (with milliseconds)
+    double time(int row) const { return m_times.at(row); }
+    QDateTime timestamp(int row) const;
+
+    // numeric values of a column, converted once
+    const QVector<double> & values(int column);
+
+  protected:
+    QFile m_file;
+    uchar * m_map;
+    QByteArray m_buffer;
+    const char * m_data;
+    QVector<qint64> m_offsets;    // line start of each record
+    QVector<int> m_lengths;       // line length of each record (trimmed)
+    QVector<double> m_times;
+    QStringList m_header;
+    QVector<QVector<double>> m_columns;
+
+    void release();
+    const char * lineData(int row) const { return m_data + m_offsets.at(row); }
+    bool findField(int row, int column, const char ** start, int * length) const;
+    static double parseTime(const char * str, int length);
+};
@@ -18,6 +18,7 @@
  * GNU General Public License for more details.
  */
 
+#include <algorithm>
 #include <math.h>
 #include "logsdialog.h"
 #include "appdata.h"
@@ -37,11 +38,13 @@ LogsDialog::LogsDialog(QWidget *parent) :
   cursorB(0),
   cursorLine(0)
 {
-  csvlog.clear();
-
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("logs.png"));
 
+  logModel = new LogModel(this);
+  ui->logTable->setModel(logModel);
+  ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+
   plotLock=false;
 
   colors.append(Qt::green);
@@ -110,13 +113,15 @@ LogsDialog::LogsDialog(QWidget *parent) :
 
   // make left axes transfer its range to right axes:
   connect(axisRect->axis(QCPAxis::atLeft), SIGNAL(rangeChanged(QCPRange)), this, SLOT(yAxisChangeRanges(QCPRange)));
+  // resample the graphs when zooming / scrolling in time:
+  connect(axisRect->axis(QCPAxis::atBottom), SIGNAL(rangeChanged(QCPRange)), this, SLOT(xAxisChangeRanges(QCPRange)));
 
   // connect some interaction slots:
   connect(ui->customPlot, SIGNAL(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)), this, SLOT(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)));
   connect(ui->customPlot, SIGNAL(axisDoubleClick(QCPAxis*,QCPAxis::SelectablePart,QMouseEvent*)), this, SLOT(axisLabelDoubleClick(QCPAxis*,QCPAxis::SelectablePart)));
   connect(ui->customPlot, SIGNAL(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*,QMouseEvent*)), this, SLOT(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*)));
   connect(ui->FieldsTW, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
-  connect(ui->logTable, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
+  connect(ui->logTable->selectionModel(), SIGNAL(selectionChanged(QItemSelection, QItemSelection)), this, SLOT(plotLogs()));
   connect(ui->Reset_PB, SIGNAL(clicked()), this, SLOT(plotLogs()));
   connect(ui->SaveSession_PB, SIGNAL(clicked()), this, SLOT(saveSession()));
 }
@@ -236,64 +241,74 @@ void LogsDialog::selectionChanged()
   }
 }
 
-QList<QStringList> LogsDialog::filterGePoints(const QList<QStringList> & input)
+QVector<int> LogsDialog::selectedLogRows()
+{
+  QVector<int> rows;
+
+  // walk the selection ranges, a selected session can be many thousand rows
+  foreach (const QItemSelectionRange & range, ui->logTable->selectionModel()->selection()) {
+    for (int row = range.top(); row <= range.bottom(); row++) {
+      rows.append(row);
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+  return rows;
+}
+
+QList<QStringList> LogsDialog::filterGePoints()
 {
   QList<QStringList> result;
 
-  int n = input.count();
-  if (n == 0) {
+  if (logModel->rowCount() == 0) {
     return result;
   }
 
-  int gpscol = 0;
-  for (int i=1; i<input.at(0).count(); i++) {
-    if (input.at(0).at(i) == "GPS") {
-      gpscol=i;
-    }
-  }
-  if (gpscol == 0) {
+  int gpscol = logModel->header().lastIndexOf("GPS");
+  if (gpscol <= 0) {
     QMessageBox::critical(this, tr("Error: no GPS data found"),
       tr("The column containing GPS coordinates must be named \"GPS\".\n\n\
 The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
     return result;
   }
 
-  result.append(input.at(0));
-  bool rangeSelected = ui->logTable->selectionModel()->selectedRows().length() > 0;
+  result.append(logModel->header());
+  QVector<int> selectedRows = selectedLogRows();
+  bool rangeSelected = selectedRows.length() > 0;
+  int n = rangeSelected ? selectedRows.length() : logModel->rowCount();
 
   GpsGlitchFilter glitchFilter;
   GpsLatLonFilter latLonFilter;
 
-  for (int i = 1; i < n; i++) {
-    if ((ui->logTable->item(i-1, 1)->isSelected() && rangeSelected) || !rangeSelected) {
-
-      GpsCoord coord = extractGpsCoordinates(input.at(i).at(gpscol));
+  for (int i = 0; i < n; i++) {
+    int row = rangeSelected ? selectedRows.at(i) : i;
+    GpsCoord coord = extractGpsCoordinates(logModel->field(row, gpscol));
 
-      // glitch filter
-      if ( glitchFilter.isGlitch(coord) ) {
-        // qDebug() << "filterGePoints(): GPS glitch detected at" << i << coord.latitude << coord.longitude;
-        continue;
-      }
-
-      // lat long pair filter
-      if ( !latLonFilter.isValid(coord) ) {
-        // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << i << coord.latitude << coord.longitude;
-        continue;
-      }
+    // glitch filter
+    if ( glitchFilter.isGlitch(coord) ) {
+      // qDebug() << "filterGePoints(): GPS glitch detected at" << i << coord.latitude << coord.longitude;
+      continue;
+    }
 
-      // qDebug() << "point " << latitude << longitude;
-      result.append(input.at(i));
+    // lat long pair filter
+    if ( !latLonFilter.isValid(coord) ) {
+      // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << i << coord.latitude << coord.longitude;
+      continue;
     }
+
+    // qDebug() << "point " << latitude << longitude;
+    result.append(logModel->record(row));
   }
 
-  // qDebug() << "filterGePoints(): filtered from" << input.count() << "to " << result.count() << "points";
+  // qDebug() << "filterGePoints(): filtered from" << n << "to " << result.count() << "points";
   return result;
 }
 
 void LogsDialog::exportToGoogleEarth()
 {
   // filter data points
-  QList<QStringList> dataPoints = filterGePoints(csvlog);
+  QList<QStringList> dataPoints = filterGePoints();
   int n = dataPoints.count(); // number of points to export
   if (n==0) return;
 
@@ -545,6 +560,7 @@ void LogsDialog::removeAllGraphs()
 {
   ui->customPlot->clearGraphs();
   ui->customPlot->clearItems();
+  graphData.clear();
   ui->customPlot->legend->setVisible(false);
   rightLegend->clearItems();
   rightLegend->setVisible(false);
@@ -572,39 +588,22 @@ void LogsDialog::on_fileOpen_BT_clicked()
     g.logDir(fileName);
     ui->FileName_LE->setText(fileName);
     if (cvsFileParse()) {
+      const QStringList & header = logModel->header();
       ui->FieldsTW->clear();
-      ui->logTable->clear();
       ui->FieldsTW->setShowGrid(false);
       ui->FieldsTW->setContentsMargins(0,0,0,0);
-      ui->FieldsTW->setRowCount(csvlog.at(0).count()-2);
+      ui->FieldsTW->setRowCount(header.count()-2);
       ui->FieldsTW->setColumnCount(1);
       ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
-      ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-      for (int i=2; i<csvlog.at(0).count(); i++) {
-        QTableWidgetItem* item= new QTableWidgetItem(csvlog.at(0).at(i));
+      for (int i=2; i<header.count(); i++) {
+        QTableWidgetItem* item= new QTableWidgetItem(header.at(i));
         ui->FieldsTW->setItem(i-2, 0, item);
       }
       ui->FieldsTW->resizeRowsToContents();
-      ui->logTable->setColumnCount(csvlog.at(0).count());
-      ui->logTable->setRowCount(csvlog.count()-1);
-      ui->logTable->setHorizontalHeaderLabels(csvlog.at(0));
-
-      QAbstractItemModel *model = ui->logTable->model();
-      for (int i=1; i<csvlog.count(); i++) {
-        for (int j=0; j<csvlog.at(0).count(); j++) {
-          model->setData(model->index(i - 1, j, QModelIndex()), csvlog.at(i).at(j));
-        }
-      }
 
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-      QVarLengthArray<int> sizes;
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        sizes.append(ui->logTable->columnWidth(i));
-      }
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        ui->logTable->setColumnWidth(i, sizes.at(i));
-      }
+      // only look at the first records to size the columns, the table may be huge
+      ui->logTable->horizontalHeader()->setResizeContentsPrecision(100);
+      ui->logTable->resizeColumnsToContents();
     }
   }
 }
@@ -614,95 +613,43 @@ void LogsDialog::saveSession()
   int index = ui->sessions_CB->currentIndex();
   // ignore index 0 is its all sessions combined
   if(index > 0) {
-    int n = csvlog.count();
-    QList<QStringList> sessionCsvLog;
-    // add CSV headers from first row of source file
-    sessionCsvLog.push_back(csvlog[0]);
-    // find session breaks
-    int currentSession = 0;
-    QDateTime lastvalue;
-    for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-        currentSession++;
-      }
-      lastvalue = tmp;
-      if(currentSession == index) {
-        // add records to filtered list
-        sessionCsvLog.push_back(csvlog[i]);
-      }
-      else if (currentSession > index) {
-        break;
-      }
+    int first = ui->sessions_CB->itemData(index, Qt::UserRole).toInt();
+    int last;
+    if (index < ui->sessions_CB->count() - 1) {
+      last = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
+    } else {
+      last = logModel->rowCount();
     }
-    // save the filtered records to a new file
+    // save the session records to a new file
     QString newFilename = logFilename;
     newFilename.append(QString("-Session%1.csv").arg(index));
     QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);", 0, 0); // getting the filename (full path)
     QFile data(filename);
     if(data.open(QFile::WriteOnly |QFile::Truncate)) {
-      QTextStream output(&data);
-      int numRecords = sessionCsvLog.count();
-      for(int i = 0; i < numRecords; i++){
-        output << sessionCsvLog[i].join(",") << '\n';
+      // add CSV headers from first row of source file
+      data.write(logModel->header().join(",").toUtf8() + '\n');
+      for (int row = first; row < last; row++) {
+        data.write(logModel->line(row) + '\n');
       }
     }
-    sessionCsvLog.clear();
   }
 }
 
 bool LogsDialog::cvsFileParse()
 {
-  QFile file(ui->FileName_LE->text());
   int errors=0;
   int lines=-1;
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  logFilename.clear();
+  if (!logModel->load(ui->FileName_LE->text(), &errors, &lines)) {
     return false;
   }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
-
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
-    }
-    else {
-      return false;
-    }
-
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
-    }
-
-    logFilename = QFileInfo(file.fileName()).baseName();
-  }
 
-  file.close();
+  logFilename = QFileInfo(ui->FileName_LE->text()).baseName();
   if (errors > 1) {
     QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
   }
 
-  int n = csvlog.count();
-  if (n == 1) {
-    csvlog.clear();
-    return false;
-  }
-
   plotLock = true;
   setFlightSessions();
   plotLock = false;
@@ -715,14 +662,6 @@ struct FlightSession {
   QDateTime end;
 };
 
-QDateTime LogsDialog::getRecordTimeStamp(int index)
-{
-  QString tstamp = csvlog.at(index).at(0) + " " + csvlog.at(index).at(1);
-  if (csvlog.at(index).at(1).contains("."))
-    return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss.zzz");
-  return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss");
-}
-
 QString LogsDialog::generateDuration(const QDateTime & start, const QDateTime & end)
 {
   int secs = start.secsTo(end);
@@ -740,35 +679,32 @@ void LogsDialog::setFlightSessions()
   ui->sessions_CB->clear();
   ui->SaveSession_PB->setEnabled(false);
 
-  int n = csvlog.count();
+  int n = logModel->rowCount();
   // qDebug() << "records" << n;
 
   // find session breaks
   QList<int> sessions;
-  QDateTime lastvalue;
-  for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-      sessions.push_back(i-1);
-      // qDebug() << "session index" << i-1;
+  for (int i = 0; i < n; i++) {
+    if (i == 0 || logModel->time(i) - logModel->time(i-1) > 60) {
+      sessions.push_back(i);
+      // qDebug() << "session index" << i;
     }
-    lastvalue = tmp;
   }
-  sessions.push_back(n-1);
+  sessions.push_back(n);
 
   //now construct a list of sessions with their times
   //total time
   int noSesions = sessions.size()-1;
   QString label = QString("%1 ").arg(noSesions);
   label += tr(noSesions > 1 ? "sessions" : "session");
-  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(1), getRecordTimeStamp(n-1)) + ">";
+  label += " <" + tr("time span") + generateDuration(logModel->timestamp(0), logModel->timestamp(n-1)) + ">";
   ui->sessions_CB->addItem(label);
 
   // add individual sessions
   if (sessions.size() > 2) {
     for (int i = 1; i < sessions.size(); i++) {
-      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1)+1);
-      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i));
+      QDateTime sessionStart = logModel->timestamp(sessions.at(i-1));
+      QDateTime sessionEnd = logModel->timestamp(sessions.at(i)-1);
       QString label = sessionStart.toString("HH:mm:ss") + " <" + tr("duration ") + generateDuration(sessionStart, sessionEnd) + ">";
       ui->sessions_CB->addItem(label, sessions.at(i-1));
       // qDebug() << "added label" << label << sessions.at(i-1);
@@ -788,13 +724,13 @@ void LogsDialog::on_sessions_CB_currentIndexChanged(int index)
     if (index < ui->sessions_CB->count() - 1) {
       bottom = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     } else {
-      bottom = ui->logTable->rowCount();
+      bottom = logModel->rowCount();
     }
 
     QModelIndex topLeft = ui->logTable->model()->index(
       ui->sessions_CB->itemData(index, Qt::UserRole).toInt(), 0 , QModelIndex());
     QModelIndex bottomRight = ui->logTable->model()->index(
-      bottom - 1, ui->logTable->columnCount() - 1, QModelIndex());
+      bottom - 1, logModel->columnCount() - 1, QModelIndex());
 
     QItemSelection selection(topLeft, bottomRight);
     ui->logTable->selectionModel()->select(selection, QItemSelectionModel::Select);
@@ -820,21 +756,9 @@ void LogsDialog::plotLogs()
 
   plotsCollection plots;
 
-  QModelIndexList selection = ui->logTable->selectionModel()->selectedRows();
-  int rowCount = selection.length();
-  bool hasLogSelection;
-  QVarLengthArray<int> selectedRows;
-
-  if (rowCount) {
-    hasLogSelection = true;
-    foreach (QModelIndex index, selection) {
-      selectedRows.append(index.row());
-    }
-    std::sort(selectedRows.begin(), selectedRows.end());
-  } else {
-    hasLogSelection = false;
-    rowCount = ui->logTable->rowCount();
-  }
+  QVector<int> selectedRows = selectedLogRows();
+  bool hasLogSelection = selectedRows.length() > 0;
+  int rowCount = hasLogSelection ? selectedRows.length() : logModel->rowCount();
 
   plots.min_x = QDateTime::currentDateTime().toTime_t();
   plots.max_x = 0;
@@ -842,42 +766,25 @@ void LogsDialog::plotLogs()
   foreach (QTableWidgetItem *plot, ui->FieldsTW->selectedItems()) {
     coords_t plotCoords;
     int plotColumn = plot->row() + 2; // Date and Time first
+    const QVector<double> & values = logModel->values(plotColumn);
 
     plotCoords.min_y = INVALID_MIN;
     plotCoords.max_y = INVALID_MAX;
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
+    plotCoords.x.reserve(rowCount);
+    plotCoords.y.reserve(rowCount);
 
-    for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QString time_str;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        time_str = ui->logTable->item(selectedRows.at(row), 0)->text() +
-          QString(" ") + ui->logTable->item(selectedRows.at(row), 1)->text();
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        time_str = ui->logTable->item(row, 0)->text() + QString(" ") +
-          ui->logTable->item(row, 1)->text();
-      }
+    for (int i = 0; i < rowCount; i++) {
+      int row = hasLogSelection ? selectedRows.at(i) : i;
+      double y = values.at(row);
+      double time = logModel->time(row);
 
-      y = logValue->text().toDouble();
       plotCoords.y.push_back(y);
 
       if (plotCoords.min_y > y) plotCoords.min_y = y;
       if (plotCoords.max_y < y) plotCoords.max_y = y;
 
-      if (time_str.contains('.')) {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss.zzz")
-          .toTime_t();
-        time += time_str.mid(time_str.indexOf('.')).toDouble();
-      } else {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss")
-          .toTime_t();
-      }
       plotCoords.x.push_back(time);
 
       if (plots.min_x > time) plots.min_x = time;
@@ -1045,8 +952,8 @@ void LogsDialog::plotLogs()
         break;
     }
 
-    ui->customPlot->graph(i)->setData(plots.coords.at(i).x,
-      plots.coords.at(i).y);
+    graphData.append(plots.coords.at(i));
+    setGraphData(i, axisRect->axis(QCPAxis::atBottom)->range());
     pen.setColor(colors.at(i % colors.size()));
     ui->customPlot->graph(i)->setPen(pen);
 
@@ -1108,6 +1015,59 @@ void LogsDialog::yAxisChangeRanges(QCPRange range)
   }
 }
 
+void LogsDialog::xAxisChangeRanges(QCPRange range)
+{
+  for (int i = 0; i < graphData.size(); i++) {
+    setGraphData(i, range);
+  }
+}
+
+// Only keep the lowest and highest value of each horizontal pixel of the
+// visible range (plus the neighbour points so lines reach the borders):
+// what is drawn stays the same, but long logs don't need millions of points.
+void LogsDialog::setGraphData(int index, const QCPRange & range)
+{
+  const coords_t & c = graphData.at(index);
+  QCPGraph * graph = ui->customPlot->graph(index);
+  const int buckets = qMax(axisRect->width(), 500);
+  const int count = c.x.count();
+  const double width = range.size() / buckets;
+
+  if (count <= 4 * buckets || width <= 0) {
+    graph->setData(c.x, c.y);
+    return;
+  }
+
+  int first = 0;
+  int last = count;
+  if (std::is_sorted(c.x.constBegin(), c.x.constEnd())) {
+    first = qMax<int>(std::lower_bound(c.x.constBegin(), c.x.constEnd(), range.lower) - c.x.constBegin() - 1, 0);
+    last = qMin<int>(std::upper_bound(c.x.constBegin(), c.x.constEnd(), range.upper) - c.x.constBegin() + 1, count);
+  }
+
+  QVector<double> x, y;
+  x.reserve(2 * buckets + 4);
+  y.reserve(2 * buckets + 4);
+
+  for (int i = first; i < last;) {
+    const int bucket = floor((c.x.at(i) - range.lower) / width);
+    int minIdx = i, maxIdx = i;
+    int j = i + 1;
+    for (; j < last && floor((c.x.at(j) - range.lower) / width) == bucket; j++) {
+      if (c.y.at(j) < c.y.at(minIdx)) minIdx = j;
+      if (c.y.at(j) > c.y.at(maxIdx)) maxIdx = j;
+    }
+    x.append(c.x.at(qMin(minIdx, maxIdx)));
+    y.append(c.y.at(qMin(minIdx, maxIdx)));
+    if (minIdx != maxIdx) {
+      x.append(c.x.at(qMax(minIdx, maxIdx)));
+      y.append(c.y.at(qMax(minIdx, maxIdx)));
+    }
+    i = j;
+  }
+
+  graph->setData(x, y);
+}
 
 void LogsDialog::addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph) {
   // find max altitude
@@ -24,6 +24,7 @@
 #include <QtCore>
 #include <QDialog>
 #include "qcustomplot.h"
+#include "logmodel.h"
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -82,9 +83,10 @@ private slots:
   void on_sessions_CB_currentIndexChanged(int index);
   void on_mapsButton_clicked();
   void yAxisChangeRanges(QCPRange range);
+  void xAxisChangeRanges(QCPRange range);
 
 private:
-  QList<QStringList> csvlog;
+  LogModel *logModel;
   Ui::LogsDialog *ui;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
@@ -94,6 +96,8 @@ private:
   QVarLengthArray<Qt::GlobalColor> colors;
   QPen pen;
 
+  QList<coords_t> graphData;  // full resolution data of each graph
+
   double yAxesRatios[AXES_LIMIT];
   minMax_t yAxesRanges[AXES_LIMIT];
 
@@ -103,11 +107,12 @@ private:
   QCPItemStraightLine * cursorLine;
 
   bool cvsFileParse();
-  QList<QStringList> filterGePoints(const QList<QStringList> & input);
+  QVector<int> selectedLogRows();
+  QList<QStringList> filterGePoints();
   void exportToGoogleEarth();
-  QDateTime getRecordTimeStamp(int index);
   QString generateDuration(const QDateTime & start, const QDateTime & end);
   void setFlightSessions();
+  void setGraphData(int index, const QCPRange & range);
 
   void addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph);
   void countNumberOfThrows(const coords_t & c, QCPGraph * graph);
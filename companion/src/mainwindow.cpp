@@ -480,6 +480,8 @@ void MainWindow::sdsync(bool postUpdate)
     syncOpts.folderA = QString();
     syncOpts.folderB = QString();
     syncOpts.sessionId = g.sessionId();
+    if (Boards::getCapability(getCurrentBoard(), Board::HasColorLcd))
+      syncOpts.flags |= SyncProcess::OPT_NATIVE_IMAGES;
   }
 
   if (postUpdate)
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <ExportableTableView>
+#include <QProgressDialog>
 
 MdiChild::MdiChild(QWidget * parent, QWidget * parentWin, Qt::WindowFlags f):
   QWidget(parent, f),
@@ -1264,7 +1265,18 @@ bool MdiChild::loadFile(const QString & filename, bool resetCurrentFile)
   }
 
   Storage storage(filename);
-  if (!storage.load(radioData)) {
+  bool loaded;
+  {
+    QProgressDialog progress(tr("Loading models..."), QString(), 0, 0, this);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+    storage.setProgressCallback([&progress](int done, int total) {
+      progress.setMaximum(total);
+      progress.setValue(done);
+    });
+    loaded = storage.load(radioData);
+  }
+  if (!loaded) {
     QMessageBox::critical(this, CPN_STR_TTL_ERROR, storage.error());
     return false;
   }
@@ -224,6 +224,7 @@ void TimerPanel::onModeChanged(int index)
 #define MASK_MULTI_DSM_OPT         (1<<19)
 #define MASK_CHANNELMAP            (1<<20)
 #define MASK_MULTI_BAYANG_OPT      (1<<21)
+#define MASK_CRSF                  (1<<22)
 
 quint8 ModulePanel::failsafesValueDisplayType = ModulePanel::FAILSAFE_DISPLAY_PERCENT;
 
@@ -471,8 +472,12 @@ void ModulePanel::update()
         max_rx_num = 20;
         break;
       case PULSES_CROSSFIRE:
-        mask |= MASK_CHANNELS_RANGE | MASK_RX_NUMBER | MASK_BAUDRATE;
-        module.channelsCount = 16;
+        mask |= MASK_CHANNELS_RANGE | MASK_RX_NUMBER | MASK_BAUDRATE | MASK_CRSF;
+        // the number of channels is only used by subset frames
+        if (module.crsf.subsetChannels)
+          mask |= MASK_CHANNELS_COUNT;
+        else
+          module.channelsCount = 16;
         ui->telemetryBaudrate->setModel(ModuleData::telemetryBaudrateItemModel(protocol));
         ui->telemetryBaudrate->setField(module.crsf.telemetryBaudrate);
         break;
@@ -728,6 +733,12 @@ void ModulePanel::update()
     ui->raw12bits->setChecked(module.ghost.raw12bits);
   }
 
+  // Crossfire settings fields
+  ui->subsetChannels->setVisible(mask & MASK_CRSF);
+  if (mask & MASK_CRSF) {
+    ui->subsetChannels->setChecked(module.crsf.subsetChannels);
+  }
+
   if (mask & MASK_ACCESS) {
     ui->rx1->setText(module.access.receiverName[0]);
     ui->rx2->setText(module.access.receiverName[1]);
@@ -1001,6 +1012,16 @@ void ModulePanel::on_raw12bits_stateChanged(int state)
   module.ghost.raw12bits = (state == Qt::Checked);
 }
 
+void ModulePanel::on_subsetChannels_stateChanged(int state)
+{
+  if (!lock && module.crsf.subsetChannels != (state == Qt::Checked)) {
+    module.crsf.subsetChannels = (state == Qt::Checked);
+    update();
+    emit channelsRangeChanged();
+    emit modified();
+  }
+}
+
 void ModulePanel::on_racingMode_stateChanged(int state)
 {
   module.access.racingMode = (state == Qt::Checked);
@@ -100,6 +100,7 @@ class ModulePanel : public ModelPanel
     void on_autoBind_stateChanged(int state);
     void on_disableChMap_stateChanged(int state);
     void on_raw12bits_stateChanged(int state);
+    void on_subsetChannels_stateChanged(int state);
     void on_racingMode_stateChanged(int state);
     void on_disableTelem_stateChanged(int state);
     void on_lowPower_stateChanged(int state);
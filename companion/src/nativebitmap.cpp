@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "nativebitmap.h"
+
+#include "radio/src/thirdparty/libopenui/src/native_bitmap.h"
+#include "radio/src/thirdparty/libopenui/thirdparty/lz4/lz4.h"
+
+#include <QtEndian>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QObject>
+#include <QSaveFile>
+
+// same conversions as BitmapBuffer::convert_stb_bitmap()
+#define RGB565(r, g, b)       (quint16)((((r) & 0xF8) << 8) + (((g) & 0xFC) << 3) + (((b) & 0xF8) >> 3))
+#define ARGB4444(a, r, g, b)  (quint16)((((a) & 0xF0) << 8) + (((r) & 0xF0) << 4) + (((g) & 0xF0) << 0) + (((b) & 0xF0) >> 4))
+
+// The radio decodes images with 4 channels into ARGB4444 and everything
+// else into RGB565: look at the PNG header to take the same decision.
+static bool pngHasAlphaChannel(const QString & path)
+{
+  QFile file(path);
+  if (!file.open(QFile::ReadOnly))
+    return false;
+
+  const QByteArray hdr = file.read(33);
+  if (hdr.size() < 33 || !hdr.startsWith("\x89PNG") || hdr.mid(12, 4) != "IHDR")
+    return false;
+
+  const quint8 colorType = hdr.at(25);
+  if (colorType == 6)       // RGBA
+    return true;
+  if (colorType != 3)       // only palette images may get an alpha channel from tRNS
+    return false;
+
+  file.seek(8);
+  while (!file.atEnd()) {
+    const QByteArray chunk = file.read(8);
+    if (chunk.size() < 8)
+      break;
+    const QByteArray type = chunk.mid(4, 4);
+    if (type == "tRNS")
+      return true;
+    if (type == "IDAT" || type == "IEND")
+      break;
+    file.seek(file.pos() + qFromBigEndian<quint32>(chunk.constData()) + 4);  // data + CRC
+  }
+  return false;
+}
+
+bool NativeBitmap::isConvertible(const QString & path)
+{
+  const QString suffix = QFileInfo(path).suffix().toLower();
+  return suffix == "png" || suffix == "jpg" || suffix == "jpeg";
+}
+
+bool NativeBitmap::isNativeBitmap(const QString & path)
+{
+  return path.endsWith(NATIVE_BITMAP_EXT, Qt::CaseInsensitive);
+}
+
+QString NativeBitmap::nativePath(const QString & imagePath)
+{
+  return imagePath + NATIVE_BITMAP_EXT;
+}
+
+bool NativeBitmap::needsUpdate(const QString & imagePath)
+{
+  const QFileInfo native(nativePath(imagePath));
+  return !native.exists() || native.lastModified() < QFileInfo(imagePath).lastModified();
+}
+
+// FAT date and time, as reported by f_stat() on the radio
+static quint32 fatTimestamp(const QDateTime & time)
+{
+  const QDate d = time.date();
+  const QTime t = time.time();
+  if (d.year() < 1980)
+    return 0;
+  return (quint32)(((d.year() - 1980) << 9) | (d.month() << 5) | d.day()) << 16 |
+         ((t.hour() << 11) | (t.minute() << 5) | (t.second() / 2));
+}
+
+bool NativeBitmap::convert(const QString & imagePath, QString * error)
+{
+  QImage image(imagePath);
+  if (image.isNull()) {
+    if (error)
+      *error = QObject::tr("Cannot read image '%1'").arg(imagePath);
+    return false;
+  }
+
+  const bool alpha = QFileInfo(imagePath).suffix().toLower() == "png" && pngHasAlphaChannel(imagePath);
+  image = image.convertToFormat(QImage::Format_RGBA8888);
+
+  const int pixels = image.width() * image.height();
+  QByteArray raw(pixels * 2, Qt::Uninitialized);
+  uchar * dest = (uchar *)raw.data();
+  for (int y = 0; y < image.height(); y++) {
+    const uchar * p = image.constScanLine(y);
+    for (int x = 0; x < image.width(); x++, p += 4, dest += 2) {
+      qToLittleEndian<quint16>(alpha ? ARGB4444(p[3], p[0], p[1], p[2]) : RGB565(p[0], p[1], p[2]), dest);
+    }
+  }
+
+  QByteArray compressed(LZ4_compressBound(raw.size()), Qt::Uninitialized);
+  const int compressedSize = LZ4_compress_default(raw.constData(), compressed.data(), raw.size(), compressed.size());
+  const bool useLz4 = compressedSize > 0 && compressedSize < raw.size() * 3 / 4;
+  const QByteArray & payload = useLz4 ? compressed.left(compressedSize) : raw;
+
+  NativeBitmapHeader hdr;
+  memcpy(hdr.magic, NATIVE_BITMAP_MAGIC, sizeof(hdr.magic));
+  hdr.version = NATIVE_BITMAP_VERSION;
+  hdr.width = qToLittleEndian<quint16>(image.width());
+  hdr.height = qToLittleEndian<quint16>(image.height());
+  hdr.format = alpha ? NATIVE_BITMAP_ARGB4444 : NATIVE_BITMAP_RGB565;
+  hdr.compression = useLz4 ? NATIVE_BITMAP_LZ4 : NATIVE_BITMAP_RAW;
+  hdr.reserved = 0;
+  hdr.length = qToLittleEndian<quint32>(payload.size());
+  hdr.sourceTime = qToLittleEndian<quint32>(fatTimestamp(QFileInfo(imagePath).lastModified()));
+
+  QSaveFile file(nativePath(imagePath));
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write((const char *)&hdr, sizeof(hdr)) != sizeof(hdr) ||
+      file.write(payload) != payload.size() ||
+      !file.commit()) {
+    if (error)
+      *error = QObject::tr("Cannot write '%1': %2").arg(file.fileName(), file.errorString());
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <QString>
+
+// Conversion of SD card images to the pre-decoded bitmap format loaded
+// natively by color LCD radios (see radio/.../libopenui/src/native_bitmap.h)
+namespace NativeBitmap
+{
+  // true for images the radio decodes at runtime (PNG, JPEG)
+  bool isConvertible(const QString & path);
+  // true for files generated by convert()
+  bool isNativeBitmap(const QString & path);
+  // "<image>.ebm"
+  QString nativePath(const QString & imagePath);
+  // true if the native bitmap is missing or older than the image
+  bool needsUpdate(const QString & imagePath);
+  // writes nativePath(imagePath), LZ4 compressed when it is worth it
+  bool convert(const QString & imagePath, QString * error = nullptr);
+}
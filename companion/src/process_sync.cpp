@@ -19,11 +19,16 @@
  */
 
 #include "process_sync.h"
+#include "nativebitmap.h"
 
 #include <QApplication>
 #include <QCryptographicHash>
 #include <QElapsedTimer>
 #include <QMutexLocker>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThreadPool>
 
 #define SYNC_MAX_ERRORS       50  // give up after this many errors per destination
 
@@ -52,6 +57,148 @@
   #define FILTER_RE_SYNTX     QRegExp::WildcardUnix
 #endif
 
+#define MANIFEST_HEADER       "# EdgeTX SD sync manifest v1"
+#define HASH_BLOCK_SIZE       (256 * 1024)
+
+SyncManifest::SyncManifest(const QString & rootPath) :
+  m_root(rootPath),
+  m_dirty(false)
+{
+  load();
+}
+
+QString SyncManifest::relativePath(const QFileInfo & fileInfo) const
+{
+  return m_root.relativeFilePath(fileInfo.absoluteFilePath());
+}
+
+void SyncManifest::load()
+{
+  QFile file(m_root.absoluteFilePath(SYNC_MANIFEST_NAME));
+  if (!file.open(QFile::ReadOnly | QFile::Text))
+    return;
+
+  QTextStream in(&file);
+  in.setCodec("UTF-8");
+  if (in.readLine() != MANIFEST_HEADER)
+    return;
+
+  while (!in.atEnd()) {
+    // hash <tab> size <tab> mtime <tab> path
+    const QStringList fields = in.readLine().split('\t');
+    if (fields.size() != 4)
+      continue;
+    Entry entry = { fields[1].toLongLong(), fields[2].toLongLong(), QByteArray::fromHex(fields[0].toLatin1()) };
+    m_entries.insert(fields[3], entry);
+  }
+}
+
+bool SyncManifest::save()
+{
+  QMutexLocker locker(&m_mutex);
+  if (!m_dirty)
+    return true;
+
+  QSaveFile file(m_root.absoluteFilePath(SYNC_MANIFEST_NAME));
+  if (!file.open(QFile::WriteOnly | QFile::Text))
+    return false;
+
+  QTextStream out(&file);
+  out.setCodec("UTF-8");
+  out << MANIFEST_HEADER << "\n";
+  for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+    if (!m_root.exists(it.key()))
+      continue;
+    out << it.value().hash.toHex() << '\t' << it.value().size << '\t' << it.value().mtime << '\t' << it.key() << "\n";
+  }
+  out.flush();
+
+  m_dirty = false;
+  return file.commit();
+}
+
+QByteArray SyncManifest::hashFile(const QString & path, QString * error)
+{
+  QFile file(path);
+  if (!file.open(QFile::ReadOnly)) {
+    if (error)
+      *error = file.errorString();
+    return QByteArray();
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  while (!file.atEnd()) {
+    const QByteArray block = file.read(HASH_BLOCK_SIZE);
+    if (block.isEmpty() && file.error() != QFile::NoError) {
+      if (error)
+        *error = file.errorString();
+      return QByteArray();
+    }
+    hash.addData(block);
+  }
+  return hash.result();
+}
+
+QByteArray SyncManifest::hash(const QFileInfo & fileInfo, bool * cached, QString * error)
+{
+  const QString path = relativePath(fileInfo);
+  const qint64 size = fileInfo.size();
+  const qint64 mtime = fileInfo.lastModified().toMSecsSinceEpoch();
+
+  {
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.constFind(path);
+    if (it != m_entries.constEnd() && it.value().size == size && it.value().mtime == mtime) {
+      if (cached)
+        *cached = true;
+      return it.value().hash;
+    }
+  }
+
+  if (cached)
+    *cached = false;
+
+  const QByteArray result = hashFile(fileInfo.absoluteFilePath(), error);
+  if (!result.isEmpty())
+    update(fileInfo, result);
+  return result;
+}
+
+void SyncManifest::update(const QFileInfo & fileInfo, const QByteArray & hash)
+{
+  QMutexLocker locker(&m_mutex);
+  Entry entry = { fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch(), hash };
+  m_entries.insert(relativePath(fileInfo), entry);
+  m_dirty = true;
+}
+
+// Hashes one file on a worker thread
+class SyncHashJob : public QRunnable
+{
+  public:
+    SyncHashJob(SyncManifest * manifest, const QFileInfo & fileInfo, QByteArray & result, QAtomicInt & cached):
+      manifest(manifest),
+      fileInfo(fileInfo),
+      result(result),
+      cached(cached)
+    {
+    }
+
+    void run() override
+    {
+      bool hit = false;
+      result = manifest->hash(fileInfo, &hit);
+      if (hit)
+        cached.fetchAndAddRelaxed(1);
+    }
+
+  protected:
+    SyncManifest * manifest;
+    const QFileInfo fileInfo;
+    QByteArray & result;
+    QAtomicInt & cached;
+};
+
 SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
   m_options(options),
   m_pauseTime(PAUSE_MINTM),
@@ -85,6 +232,7 @@ SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
 
 SyncProcess::~SyncProcess()
 {
+  qDeleteAll(m_manifests);
 #ifdef Q_OS_WIN
   qt_ntfs_permission_lookup--;  // global revert NTFS permissions checking
 #endif
@@ -171,6 +319,11 @@ void SyncProcess::run()
 
 void SyncProcess::finish()
 {
+  if (!(m_options.flags & OPT_DRY_RUN)) {
+    for (SyncManifest * manifest : m_manifests)
+      manifest->save();
+  }
+
   const lldiv_t elapsed = lldiv(m_startTime.secsTo(QDateTime::currentDateTime()), 60);
   QString endStr = testRunStr;
   if (m_stat.index < m_stat.count)
@@ -191,6 +344,13 @@ SyncProcess::FileFilterResult SyncProcess::fileFilter(const QFileInfo & fileInfo
   if (m_options.maxFileSize > 0 && fileInfo.isFile() && fileInfo.size() > m_options.maxFileSize)
     return FILE_OVERSIZE;
 
+  if (fileInfo.isFile() && fileInfo.fileName() == SYNC_MANIFEST_NAME)
+    return FILE_EXCLUDE;
+
+  // generated on the radio side, never copied around
+  if (fileInfo.isFile() && NativeBitmap::isNativeBitmap(fileInfo.fileName()))
+    return FILE_EXCLUDE;
+
   if (!m_excludeFilters.isEmpty() && (!(m_dirFilters & QDir::AllDirs) || fileInfo.isFile())) {
     for (QVector<QRegExp>::const_iterator it = m_excludeFilters.constBegin(), end = m_excludeFilters.constEnd(); it != end; ++it) {
       if (QRegExp(*it).exactMatch(fileInfo.fileName()))
@@ -248,6 +408,8 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
   emit statusMessage(testRunStr % tr("Synchronizing: %1\n    To: %2").arg(source, destination));
   PRINT_INFO(testRunStr % tr("Starting synchronization:\n  %1 -> %2\n").arg(source, destination));
 
+  // plan: collect everything to synchronize first...
+  QFileInfoList entries;
   QFileInfoList infoList = dirInfoList(source);
   QMutableListIterator<QFileInfo> it(infoList);
   it.toBack();
@@ -256,16 +418,8 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
     it.remove();
     if ((ffr = fileFilter(fi)) == FILE_ALLOW) {
       pushDirEntries(fi, it);
-      if ((m_dirFilters & QDir::Dirs) || fi.isFile()) {
-        updateEntry(fi.filePath(), srcDir, dstDir);
-        if (fi.isFile())
-          ++m_stat.index;
-        emit statusUpdate(m_stat);
-        if (m_stat.errored - pStat.errored > SYNC_MAX_ERRORS) {
-          PRINT_ERROR(tr("\nToo many errors, giving up."));
-          break;
-        }
-      }
+      if ((m_dirFilters & QDir::Dirs) || fi.isFile())
+        entries.append(fi);
     }
     else if (m_options.logLevel == QtDebugMsg) {
       switch (ffr) {
@@ -288,6 +442,32 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
     pause();
   }
 
+  // ...then compare contents where needed, in parallel...
+  if (!isStopRequsted())
+    prepareHashes(entries, srcDir, dstDir);
+
+  // ...and copy (images are only converted on the radio side, folder B)
+  const bool nativeImages = (m_options.flags & OPT_NATIVE_IMAGES) && dstDir == QDir(m_options.folderB);
+  for (const QFileInfo & fi : entries) {
+    if (isStopRequsted())
+      break;
+    if (updateEntry(fi.filePath(), srcDir, dstDir) && fi.isFile() && nativeImages &&
+        NativeBitmap::isConvertible(fi.fileName())) {
+      updateNativeImage(destinationPath(fi.filePath(), srcDir, dstDir));
+    }
+    if (fi.isFile())
+      ++m_stat.index;
+    emit statusUpdate(m_stat);
+    if (m_stat.errored - pStat.errored > SYNC_MAX_ERRORS) {
+      PRINT_ERROR(tr("\nToo many errors, giving up."));
+      break;
+    }
+    // throttle if needed
+    m_pauseTime = qMax(m_pauseTime - PAUSE_RECOVERY, PAUSE_MINTM);
+    pause();
+  }
+  m_hashes.clear();
+
   QString endStr = "\n" % testRunStr;
   if (isStopRequsted())
     endStr.append(tr("Aborted synchronization of:"));
@@ -295,14 +475,82 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
     endStr.append(tr("Finished synchronizing:"));
   endStr.append(QString("\n  %1 -> %2\n  ").arg(source, destination));
   endStr.append(tr("Created: %1; Updated: %2; Skipped: %3; Errors: %4;").arg(m_stat.created-pStat.created).arg(m_stat.updated-pStat.updated).arg(m_stat.skipped-pStat.skipped).arg(m_stat.errored-pStat.errored));
+  endStr.append("\n  ");
+  endStr.append(tr("Compared: %1 (%2 from manifest); Copied: %3KB;").arg(m_stat.hashed-pStat.hashed+m_stat.cached-pStat.cached).arg(m_stat.cached-pStat.cached).arg((m_stat.bytes-pStat.bytes) / 1024));
   PRINT_INFO(endStr);
   PRINT_SEP();
 }
 
+QString SyncProcess::destinationPath(const QString & entry, const QDir & source, const QDir & destination) const
+{
+  return QDir::toNativeSeparators(destination.absoluteFilePath(source.relativeFilePath(entry)));
+}
+
+SyncManifest * SyncProcess::manifest(const QDir & root)
+{
+  const QString path = root.absolutePath();
+  SyncManifest * manifest = m_manifests.value(path);
+  if (!manifest) {
+    manifest = new SyncManifest(path);
+    m_manifests.insert(path, manifest);
+  }
+  return manifest;
+}
+
+// Hash all the files which need a content comparison before anything gets copied,
+// reading source and destination in parallel. Files unchanged since the last sync
+// (same size and modification time) take their hash from the manifest instead.
+void SyncProcess::prepareHashes(const QFileInfoList & entries, const QDir & source, const QDir & destination)
+{
+  m_hashes.clear();
+  if (!(m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_IF_DIFF))
+    return;
+
+  SyncManifest * srcManifest = manifest(source);
+  SyncManifest * dstManifest = manifest(destination);
+  QList<QPair<QFileInfo, SyncManifest *>> files;
+
+  for (const QFileInfo & fi : entries) {
+    if (!fi.isFile())
+      continue;
+    const QFileInfo destInfo(destinationPath(fi.filePath(), source, destination));
+    // a missing or different sized file doesn't need to be read
+    if (!destInfo.isFile() || destInfo.size() != fi.size())
+      continue;
+    if (m_options.compareType == OVERWR_NEWER_IF_DIFF && fi.lastModified() <= destInfo.lastModified())
+      continue;
+    files.append(qMakePair(fi, srcManifest));
+    files.append(qMakePair(destInfo, dstManifest));
+  }
+  if (files.isEmpty())
+    return;
+
+  emit statusMessage(tr("Comparing %1 files...").arg(files.size() / 2));
+
+  QVector<QByteArray> results(files.size());
+  QAtomicInt cached;
+  QThreadPool pool;
+  for (int i = 0; i < files.size(); i++)
+    pool.start(new SyncHashJob(files[i].second, files[i].first, results[i], cached));
+
+  while (!pool.waitForDone(50)) {
+    if (isStopRequsted())
+      pool.clear();
+    QApplication::processEvents();
+  }
+
+  for (int i = 0; i < files.size(); i++) {
+    if (!results[i].isEmpty())
+      m_hashes.insert(files[i].first.absoluteFilePath(), results[i]);
+  }
+  m_stat.cached += cached.load();
+  m_stat.hashed += files.size() - cached.load();
+}
+
 bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const QDir & destination)
 {
   const QString srcPath = QDir::toNativeSeparators(source.absoluteFilePath(entry));
-  const QString destPath = QDir::toNativeSeparators(destination.absoluteFilePath(source.relativeFilePath(entry)));
+  const QString destPath = destinationPath(entry, source, destination);
   const QFileInfo sourceInfo(srcPath);
   const QFileInfo destInfo(destPath);
   static QString lastMkPath;
@@ -358,21 +606,30 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
     checkDate = false;
   }
 
+  QByteArray srcHash;
   if (destExists && checkContent) {
-    if (!sourceFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, sourceFile.errorString()));
-      ++m_stat.errored;
-      return false;
-    }
-    if (!destinationFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, destinationFile.errorString()));
-      ++m_stat.errored;
-      return false;
+    bool skip = false;
+    // files of different size can't be identical
+    if (sourceInfo.size() == destInfo.size()) {
+      QString error;
+      srcHash = m_hashes.value(sourceInfo.absoluteFilePath());
+      if (srcHash.isEmpty())
+        srcHash = manifest(source)->hash(sourceInfo, nullptr, &error);
+      if (srcHash.isEmpty()) {
+        PRINT_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, error));
+        ++m_stat.errored;
+        return false;
+      }
+      QByteArray destHash = m_hashes.value(destInfo.absoluteFilePath());
+      if (destHash.isEmpty())
+        destHash = manifest(destination)->hash(destInfo, nullptr, &error);
+      if (destHash.isEmpty()) {
+        PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, error));
+        ++m_stat.errored;
+        return false;
+      }
+      skip = (srcHash == destHash);
     }
-
-    const bool skip = QCryptographicHash::hash(sourceFile.readAll(), QCryptographicHash::Md5) == QCryptographicHash::hash(destinationFile.readAll(), QCryptographicHash::Md5);
-    sourceFile.close();
-    destinationFile.close();
     if (skip) {
       PRINT_SKIP(tr("Skipping identical file: %1").arg(srcPath));
       ++m_stat.skipped;
@@ -400,6 +657,11 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
       return false;
     }
 
+    // the copy has the source contents, no need to read it again next time
+    if (!(m_options.flags & OPT_DRY_RUN) && !srcHash.isEmpty())
+      manifest(destination)->update(QFileInfo(destPath), srcHash);
+
+    m_stat.bytes += sourceInfo.size();
     if (existed)
       ++m_stat.updated;
     else
@@ -409,6 +671,25 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
   return true;
 }
 
+bool SyncProcess::updateNativeImage(const QString & imagePath)
+{
+  if (!QFileInfo::exists(imagePath) || !NativeBitmap::needsUpdate(imagePath))
+    return true;
+
+  PRINT_CREATE(tr("Converting image: %1").arg(imagePath));
+  if (m_options.flags & OPT_DRY_RUN)
+    return true;
+
+  QString error;
+  if (!NativeBitmap::convert(imagePath, &error)) {
+    PRINT_ERROR(error);
+    ++m_stat.errored;
+    return false;
+  }
+
+  return true;
+}
+
 void SyncProcess::pause()
 {
   QElapsedTimer tim;
@@ -26,10 +26,47 @@
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
 #include <QReadWriteLock>
 #include <QRegExp>
 #include <QVector>
 
+#define SYNC_MANIFEST_NAME    ".edgetx-sync"
+
+// Persisted list of path / size / modification time / content hash of the
+// files below a synchronized folder, so that unchanged files do not need
+// to be read again to be compared.
+class SyncManifest
+{
+  public:
+    explicit SyncManifest(const QString & rootPath);
+
+    // returns the content hash, from the manifest if size and time match (thread-safe)
+    QByteArray hash(const QFileInfo & fileInfo, bool * cached = nullptr, QString * error = nullptr);
+    // file was written by the sync, hash is known
+    void update(const QFileInfo & fileInfo, const QByteArray & hash);
+    bool save();
+
+    static QByteArray hashFile(const QString & path, QString * error = nullptr);
+
+  protected:
+    struct Entry {
+      qint64 size;
+      qint64 mtime;
+      QByteArray hash;
+    };
+
+    QString relativePath(const QFileInfo & fileInfo) const;
+    void load();
+
+    QDir m_root;
+    QHash<QString, Entry> m_entries;
+    QMutex m_mutex;
+    bool m_dirty;
+};
+
 class SyncProcess : public QObject
 {
     Q_OBJECT
@@ -56,7 +93,8 @@ class SyncProcess : public QObject
       OPT_DRY_RUN         = 0x01,
       OPT_SKIP_EMPTY_DIR  = 0x02,
       OPT_RECURSIVE       = 0x04,
-      OPT_SKIP_DIR_LINKS  = 0x08
+      OPT_SKIP_DIR_LINKS  = 0x08,
+      OPT_NATIVE_IMAGES   = 0x10   // write pre-decoded images for color radios
     };
     Q_DECLARE_FLAGS(SyncOptionFlags, SyncOptionFlag)
     Q_FLAG(SyncOptionFlags)
@@ -102,6 +140,9 @@ class SyncProcess : public QObject
         int updated;
         int skipped;
         int errored;
+        int hashed;      // files read to compare contents
+        int cached;      // content hashes taken from the manifest
+        qint64 bytes;    // bytes copied (or to be copied on test run)
         void clear() { memset(this, 0, sizeof(SyncStatus)); }
     };
 
@@ -131,6 +172,10 @@ class SyncProcess : public QObject
     void updateDir(const QString & source, const QString & destination);
     void pushDirEntries(const QFileInfo & fi, QMutableListIterator<QFileInfo> &it);
     bool updateEntry(const QString & entry, const QDir & source, const QDir & destination);
+    void prepareHashes(const QFileInfoList & entries, const QDir & source, const QDir & destination);
+    SyncManifest * manifest(const QDir & root);
+    QString destinationPath(const QString & entry, const QDir & source, const QDir & destination) const;
+    bool updateNativeImage(const QString & imagePath);
     void pause();
     void emitProgressMessage(const QString &text, int type);
 
@@ -142,6 +187,8 @@ class SyncProcess : public QObject
     QStringList m_dirIteratorFilters;
     QDir::Filters m_dirFilters;
     QDateTime m_startTime;
+    QMap<QString, SyncManifest *> m_manifests;
+    QHash<QString, QByteArray> m_hashes;  // absolute path -> content hash, for the current folder pair
     unsigned long m_pauseTime;
     bool stopping;
 };
@@ -23,6 +23,15 @@
 
 #define MZ_ALLOCATION_SIZE    (32*1024)
 
+static size_t zipFileRead(void * opaque, mz_uint64 offset, void * buffer, size_t size)
+{
+  QFile * file = (QFile *)opaque;
+  if (!file->seek(offset))
+    return 0;
+  qint64 len = file->read((char *)buffer, size);
+  return len < 0 ? 0 : (size_t)len;
+}
+
 bool EtxFormat::load(RadioData & radioData)
 {
   QFile file(filename);
@@ -32,13 +41,13 @@ bool EtxFormat::load(RadioData & radioData)
     return false;
   }
 
-  QByteArray archiveContents = file.readAll();
-
-  qDebug() << "File" << filename << "read, size:" << archiveContents.size();
+  qDebug() << "File" << filename << "opened, size:" << file.size();
 
-  // open zip file
+  // open zip file, entries are read from the file on demand
   memset(&zip_archive, 0, sizeof(zip_archive));
-  if (!mz_zip_reader_init_mem(&zip_archive, archiveContents.data(), archiveContents.size(), 0)) {
+  zip_archive.m_pRead = zipFileRead;
+  zip_archive.m_pIO_opaque = &file;
+  if (!mz_zip_reader_init(&zip_archive, file.size(), 0)) {
     qDebug() << tr("Error opening EdgeTX archive %1").arg(filename);
     return false;
   }
@@ -25,6 +25,44 @@
 
 #include <regex>
 
+struct ModelLoadJob {
+  std::string filename;
+  int modelIdx;
+  QByteArray buffer;
+  QString error;
+};
+
+// Parses one extracted model on a worker thread
+class ModelParser : public QRunnable
+{
+  public:
+    ModelParser(ModelLoadJob & job, ModelData & model, QAtomicInt & parsed):
+      job(job),
+      model(model),
+      parsed(parsed)
+    {
+    }
+
+    void run() override
+    {
+      const QString filename = "MODELS/" + QString::fromStdString(job.filename);
+      try {
+        if (!loadModelFromYaml(model, job.buffer)) {
+          job.error = LabelsStorageFormat::tr("Cannot load ") + filename;
+        }
+      } catch(const std::runtime_error& e) {
+        job.error = LabelsStorageFormat::tr("Cannot load ") + filename + ":\n" + QString(e.what());
+      }
+      job.buffer.clear();
+      parsed.fetchAndAddRelease(1);
+    }
+
+  protected:
+    ModelLoadJob & job;
+    ModelData & model;
+    QAtomicInt & parsed;
+};
+
 bool LabelsStorageFormat::load(RadioData & radioData)
 {
   StorageType st = getStorageType(filename);
@@ -251,19 +289,25 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
     }
   }
 
-  int modelIdx = 0;
   bool hasLabels = getCurrentFirmware()->getCapability(HasModelLabels);
 
   if (hasLabels)
     radioData.models.resize(modelFiles.size());
 
+  // Assign the slots first, so that models can then be parsed concurrently
+  // straight into their final place
+  std::vector<ModelLoadJob> jobs;
+  std::vector<bool> usedSlots(radioData.models.size(), false);
+  jobs.reserve(modelFiles.size());
+
   for (const auto& mc : modelFiles) {
     qDebug() << "Filename: " << mc.filename.c_str();
 
+    int modelIdx = (int)jobs.size();
     if (!hasLabels) {
       if (mc.modelIdx >= 0 && mc.modelIdx < (int)radioData.models.size()) {
         modelIdx = mc.modelIdx;
-        if (!radioData.models[modelIdx].isEmpty()) {
+        if (usedSlots[modelIdx] || !radioData.models[modelIdx].isEmpty()) {
           qDebug() << QString("Warning: file %1 skipped as slot %2 already used").arg(mc.filename.c_str()).arg(mc.modelIdx + 1);
           continue;
         }
@@ -274,38 +318,57 @@ bool LabelsStorageFormat::loadYaml(RadioData & radioData)
       }
     }
 
-    QByteArray modelBuffer;
-    QString filename = "MODELS/" + QString::fromStdString(mc.filename);
-    if (!loadFile(modelBuffer, filename)) {
+    usedSlots[modelIdx] = true;
+    jobs.push_back({ mc.filename, modelIdx, QByteArray(), QString() });
+  }
+
+  // Extraction is sequential (shared archive / file access), parsing and
+  // conversion of the already extracted models runs on a thread pool
+  QThreadPool pool;
+  QAtomicInt parsed(0);
+  const int total = (int)jobs.size();
+  bool extracted = true;
+
+  reportProgress(0, total);
+  for (auto& job : jobs) {
+    QString filename = "MODELS/" + QString::fromStdString(job.filename);
+    if (!loadFile(job.buffer, filename)) {
       setError(tr("Cannot extract ") + filename);
-      return false;
+      extracted = false;
+      break;
     }
 
     // Please note:
     //  ModelData() use memset to clear everything to 0
     //
-    auto& model = radioData.models[modelIdx];
+    pool.start(new ModelParser(job, radioData.models[job.modelIdx], parsed));
+  }
 
-    try {
-      if (!loadModelFromYaml(model,modelBuffer)) {
-        setError(tr("Cannot load ") + filename);
-        return false;
-      }
-    } catch(const std::runtime_error& e) {
-      setError(tr("Cannot load ") + filename + ":\n" + QString(e.what()));
+  while (!pool.waitForDone(50)) {
+    reportProgress(parsed.loadAcquire(), total);
+  }
+  reportProgress(parsed.loadAcquire(), total);
+
+  if (!extracted)
+    return false;
+
+  // results are checked in file order to keep errors deterministic
+  for (const auto& job : jobs) {
+    if (!job.error.isEmpty()) {
+      setError(job.error);
       return false;
     }
 
-    model.modelIndex = modelIdx;
-    strncpy(model.filename, mc.filename.c_str(), sizeof(model.filename)-1);
+    auto& model = radioData.models[job.modelIdx];
+    model.modelIndex = job.modelIdx;
+    strncpy(model.filename, job.filename.c_str(), sizeof(model.filename)-1);
 
     if (hasLabels && !strncmp(radioData.generalSettings.currModelFilename,
                                   model.filename, sizeof(model.filename))) {
-      radioData.generalSettings.currModelIndex = modelIdx;
+      radioData.generalSettings.currModelIndex = job.modelIdx;
     }
 
     model.used = true;
-    modelIdx++;
   }
 
   // Add the labels in the models
@@ -27,6 +27,8 @@
 #include <QString>
 #include <QDebug>
 
+#include <functional>
+
 enum StorageType
 {
   STORAGE_TYPE_UNKNOWN,
@@ -74,6 +76,14 @@ class StorageFormat
       return board;
     }
 
+    // called with (models loaded, models total) while loading
+    typedef std::function<void(int, int)> ProgressCallback;
+
+    void setProgressCallback(const ProgressCallback & callback)
+    {
+      progressCallback = callback;
+    }
+
   protected:
     void setError(const QString & error)
     {
@@ -92,6 +102,13 @@ class StorageFormat
     QString _error;
     QString _warning;
     Board::Type board;
+    ProgressCallback progressCallback;
+
+    void reportProgress(int done, int total)
+    {
+      if (progressCallback)
+        progressCallback(done, total);
+    }
 };
 
 class StorageFactory
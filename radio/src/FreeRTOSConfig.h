@@ -81,6 +81,8 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay                  1
 #define INCLUDE_xTimerPendFunctionCall      1
 #define INCLUDE_uxTaskGetStackHighWaterMark 1
+#define INCLUDE_xTaskGetIdleTaskHandle      1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle 1
 
 #if defined(THREADSAFE_MALLOC)
 #define INCLUDE_xTaskGetSchedulerState  1
@@ -91,6 +93,13 @@ to exclude the API function. */
 #define INCLUDE_xTaskGetCurrentTaskHandle 1
 #endif
 
+/* CPU load accounting of each task (see tasks.cpp) */
+#ifdef __cplusplus
+extern "C"
+#endif
+void tasksSwitchedIn(const void * tcb);
+#define traceTASK_SWITCHED_IN()  tasksSwitchedIn(pxCurrentTCB)
+
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
 	/* __BVIC_PRIO_BITS will be specified when CMSIS is being used. */
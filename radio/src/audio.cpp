@@ -289,14 +289,15 @@ void referenceSystemAudioFiles()
     for (;;) {
       res = f_readdir(&dir, &fno);                   /* Read a directory item */
       if (res != FR_OK || fno.fname[0] == 0) break;  /* Break on error or end of dir */
-      uint8_t len = strlen(fno.fname);
+      size_t len = strlen(fno.fname);
 
       // Eliminates directories / non wav files
       if (len < 5 || strcasecmp(fno.fname+len-4, SOUNDS_EXT) || (fno.fattrib & AM_DIR)) continue;
 
+      // compare the names without building a full path for each candidate
+      len -= 4;
       for (int i=0; i<AU_SPECIAL_SOUND_FIRST; i++) {
-        getSystemAudioFile(path, i);
-        if (!strcasecmp(filename, fno.fname)) {
+        if (strlen(audioFilenames[i]) == len && !strncasecmp(audioFilenames[i], fno.fname, len)) {
           sdAvailableSystemAudioFiles.setBit(i);
           break;
         }
@@ -308,11 +309,21 @@ void referenceSystemAudioFiles()
 
 const char * const suffixes[] = { "-off", "-on" };
 
-char *getModelAudioPath(char *path)
+// The model sounds directory is looked up on the SD card once per model load,
+// and then reused as long as the model name and the language are unchanged
+static char modelAudioPath[AUDIO_FILENAME_MAXLEN + 1];
+static char modelAudioPathKey[AUDIO_FILENAME_MAXLEN + 1];
+
+static char * getModelAudioPathKey(char * path)
 {
   strcpy(path, SOUNDS_PATH "/");
   strncpy(path + SOUNDS_PATH_LNG_OFS, currentLanguagePack->id, 2);
-  char *buf = strcat_currentmodelname(path + sizeof(SOUNDS_PATH), ' ');
+  return strcat_currentmodelname(path + sizeof(SOUNDS_PATH), ' ');
+}
+
+static char * findModelAudioPath(char * path)
+{
+  char * buf = getModelAudioPathKey(path);
 
   if (!isFileAvailable(path)) {
     buf = strcat_currentmodelname(path + sizeof(SOUNDS_PATH), 0);
@@ -323,6 +334,25 @@ char *getModelAudioPath(char *path)
   return buf;
 }
 
+static void updateModelAudioPath()
+{
+  getModelAudioPathKey(modelAudioPathKey);
+  findModelAudioPath(modelAudioPath);
+}
+
+char *getModelAudioPath(char *path)
+{
+  getModelAudioPathKey(path);
+
+  if (strcmp(path, modelAudioPathKey)) {
+    // model renamed since it was loaded
+    return findModelAudioPath(path);
+  }
+
+  strcpy(path, modelAudioPath);
+  return path + strlen(path);
+}
+
 void getFlightmodeAudioFile(char * filename, int index, unsigned int event)
 {
   char * str = getModelAudioPath(filename);
@@ -343,7 +373,7 @@ void getSwitchAudioFile(char * filename, swsrc_t index)
     strcpy(str, positions[swinfo.rem]);
   }
   else {
-    index -= MAX_SWITCHES * 3;
+    index -= SWSRC_FIRST_SWITCH + MAX_SWITCHES * 3;
     div_t swinfo = div((int)index, XPOTS_MULTIPOS_COUNT);
     *str++ = 'S';
     *str++ = '1' + swinfo.quot;
@@ -371,6 +401,110 @@ void getLogicalSwitchAudioFile(char * filename, int index, unsigned int event)
   strcat(str, SOUNDS_EXT);
 }
 
+// Cuts the "-<suffix>" at the end of name, returns its index in suffixes
+// or -1 if none matches
+static int cutAudioFileSuffix(char * name, const char * const * suffixes, int count)
+{
+  char * suffix = strrchr(name, '-');
+  if (suffix) {
+    for (int i = 0; i < count; i++) {
+      if (!strcasecmp(suffix, suffixes[i])) {
+        *suffix = '\0';
+        return i;
+      }
+    }
+  }
+  return -1;
+}
+
+// Flight modes Audio Files <flightmodename>-[on|off].wav
+static bool referenceFlightmodeAudioFile(const char * name, int event)
+{
+  char fmName[LEN_FLIGHT_MODE_NAME + 8];
+
+  for (int i = 0; i < MAX_FLIGHT_MODES; i++) {
+    strcatFlightmodeName(fmName, i);
+    if (!strcasecmp(name, fmName)) {
+      sdAvailableFlightmodeAudioFiles.setBit(INDEX_PHASE_AUDIO_FILE(i, event));
+      return true;
+    }
+  }
+  return false;
+}
+
+// Switches Audio Files S<switchletter>-[up|mid|down].wav
+// and multipos switches S<pot><position>.wav
+static bool referenceSwitchAudioFile(char * name)
+{
+  static const char * const positions[] = { "-up", "-mid", "-down" };
+
+  if (toupper((unsigned char)name[0]) != 'S' || name[1] == '\0')
+    return false;
+
+  int pos = cutAudioFileSuffix(name, positions, DIM(positions));
+  if (pos >= 0) {
+    if (name[2] != '\0')
+      return false;
+    for (int i = 0; i < MAX_SWITCHES; i++) {
+      if ((char)toupper((unsigned char)name[1]) == switchGetLetter(i)) {
+        sdAvailableSwitchAudioFiles.setBit(3 * i + pos);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int pot = name[1] - '1';
+  pos = name[2] - '1';
+  if (name[2] == '\0' || name[3] != '\0' || pot < 0 || pot >= MAX_POTS ||
+      pos < 0 || pos >= XPOTS_MULTIPOS_COUNT)
+    return false;
+
+  sdAvailableSwitchAudioFiles.setBit(MAX_SWITCHES * 3 + pot * XPOTS_MULTIPOS_COUNT + pos);
+  return true;
+}
+
+// Logical Switches Audio Files L<index>-[on|off].wav
+static bool referenceLogicalSwitchAudioFile(const char * name, int event)
+{
+  if (toupper((unsigned char)name[0]) != 'L' || name[1] < '1' || name[1] > '9')
+    return false;
+
+  int index = 0;
+  for (const char * c = name + 1; *c; c++) {
+    if (*c < '0' || *c > '9' || index >= MAX_LOGICAL_SWITCHES)
+      return false;
+    index = index * 10 + (*c - '0');
+  }
+  if (index > MAX_LOGICAL_SWITCHES)
+    return false;
+
+  sdAvailableLogicalSwitchAudioFiles.setBit(INDEX_LOGICAL_SWITCH_AUDIO_FILE(index - 1, event));
+  return true;
+}
+
+// Finds which event a file of the model sounds directory is for, directly
+// from its name (the same names as built by get*AudioFile())
+bool referenceModelAudioFile(const char * filename)
+{
+  char name[AUDIO_FILENAME_MAXLEN + 1];
+  size_t len = strlen(filename);
+
+  if (len < 5 || len - 4 > AUDIO_FILENAME_MAXLEN || strcasecmp(filename + len - 4, SOUNDS_EXT))
+    return false;
+
+  memcpy(name, filename, len - 4);
+  name[len - 4] = '\0';
+
+  int event = cutAudioFileSuffix(name, suffixes, DIM(suffixes));
+  if (event >= 0) {
+    return referenceFlightmodeAudioFile(name, event) ||
+           referenceLogicalSwitchAudioFile(name, event);
+  }
+
+  return referenceSwitchAudioFile(name);
+}
+
 void referenceModelAudioFiles()
 {
   char path[AUDIO_FILENAME_MAXLEN+1];
@@ -381,6 +515,7 @@ void referenceModelAudioFiles()
   sdAvailableSwitchAudioFiles.reset();
   sdAvailableLogicalSwitchAudioFiles.reset();
 
+  updateModelAudioPath();
   char * filename = getModelAudioPath(path);
   *(filename-1) = '\0';
 
@@ -389,50 +524,12 @@ void referenceModelAudioFiles()
     for (;;) {
       res = f_readdir(&dir, &fno);                   /* Read a directory item */
       if (res != FR_OK || fno.fname[0] == 0) break;  /* Break on error or end of dir */
-      uint8_t len = strlen(fno.fname);
-      bool found = false;
 
-      // Eliminates directories / non wav files
-      if (len < 5 || strcasecmp(fno.fname+len-4, SOUNDS_EXT) || (fno.fattrib & AM_DIR)) continue;
-      TRACE("referenceModelAudioFiles(): using file: %s", fno.fname);
-
-      // Flight modes Audio Files <flightmodename>-[on|off].wav
-      for (int i=0; i<MAX_FLIGHT_MODES && !found; i++) {
-        for (int event=0; event<2; event++) {
-          getFlightmodeAudioFile(path, i, event);
-          // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
-          if (!strcasecmp(filename, fno.fname)) {
-            sdAvailableFlightmodeAudioFiles.setBit(INDEX_PHASE_AUDIO_FILE(i, event));
-            found = true;
-            TRACE("\tfound: %s", filename);
-            break;
-          }
-        }
-      }
+      // Eliminates directories
+      if (fno.fattrib & AM_DIR) continue;
 
-      // Switches Audio Files <switchname>-[up|mid|down].wav
-      for (unsigned i = 0; i <= MAX_SWITCH_POSITIONS && !found; i++) {
-        getSwitchAudioFile(path, i);
-        // TRACE("referenceModelAudioFiles(): searching for %s in %s (%d)", path, fno.fname, i);
-        if (!strcasecmp(filename, fno.fname)) {
-          sdAvailableSwitchAudioFiles.setBit(i);
-          found = true;
-          TRACE("\tfound: %s", filename);
-        }
-      }
-
-      // Logical Switches Audio Files <switchname>-[on|off].wav
-      for (int i=0; i<MAX_LOGICAL_SWITCHES && !found; i++) {
-        for (int event=0; event<2; event++) {
-          getLogicalSwitchAudioFile(path, i, event);
-          // TRACE("referenceModelAudioFiles(): searching for %s in %s", filename, fno.fname);
-          if (!strcasecmp(filename, fno.fname)) {
-            sdAvailableLogicalSwitchAudioFiles.setBit(INDEX_LOGICAL_SWITCH_AUDIO_FILE(i, event));
-            found = true;
-            TRACE("\tfound: %s", filename);
-            break;
-          }
-        }
+      if (referenceModelAudioFile(fno.fname)) {
+        TRACE("referenceModelAudioFiles(): found: %s", fno.fname);
       }
     }
     f_closedir(&dir);
@@ -534,7 +631,9 @@ void audioTask(void * pdata)
   while (true) {
     DEBUG_TIMER_SAMPLE(debugTimerAudioIterval);
     DEBUG_TIMER_START(debugTimerAudioDuration);
+    TRACE_EVENT_BEGIN(trace_audio);
     audioQueue.wakeup();
+    TRACE_EVENT_END(trace_audio);
     DEBUG_TIMER_STOP(debugTimerAudioDuration);
     RTOS_WAIT_MS(4);
   }
@@ -551,55 +650,120 @@ inline void mixSample(audio_data_t * result, int sample, unsigned int fade)
 #define RIFF_CHUNK_SIZE 12
 uint8_t wavBuffer[AUDIO_BUFFER_SIZE*2] __DMA;
 
-int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
+static FRESULT openWavFile(WavState & state, const char * filename)
 {
-  FRESULT result = FR_OK;
   UINT read = 0;
-
-  if (fragment.file[1]) {
-    result = f_open(&state.file, fragment.file, FA_OPEN_EXISTING | FA_READ);
-    fragment.file[1] = 0;
-    if (result == FR_OK) {
-      result = f_read(&state.file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
-      if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
-        uint32_t size = *((uint32_t *)(wavBuffer+16));
-        result = (size < 256 ? f_read(&state.file, wavBuffer, size+8, &read) : FR_DENIED);
-        if (result == FR_OK && read == size+8) {
-          state.codec = ((uint16_t *)wavBuffer)[0];
-          state.freq = ((uint16_t *)wavBuffer)[2];
-          uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
-          uint32_t size = wavSamplesPtr[1];
-          if (state.freq != 0 && state.freq * (AUDIO_SAMPLE_RATE / state.freq) == AUDIO_SAMPLE_RATE) {
-            state.resampleRatio = (AUDIO_SAMPLE_RATE / state.freq);
-            state.readSize = (state.codec == CODEC_ID_PCM_S16LE ? 2*AUDIO_BUFFER_SIZE : AUDIO_BUFFER_SIZE) / state.resampleRatio;
-          }
-          else {
-            result = FR_DENIED;
-          }
-          while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
-            result = f_lseek(&state.file, f_tell(&state.file)+size);
-            if (result == FR_OK) {
-              result = f_read(&state.file, wavBuffer, 8, &read);
-              if (read != 8) result = FR_DENIED;
-              wavSamplesPtr = (uint32_t *)wavBuffer;
-              size = wavSamplesPtr[1];
-            }
-          }
-          state.size = size;
+  FRESULT result = f_open(&state.file, filename, FA_OPEN_EXISTING | FA_READ);
+  if (result == FR_OK) {
+    result = f_read(&state.file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
+    if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
+      uint32_t size = *((uint32_t *)(wavBuffer+16));
+      result = (size < 256 ? f_read(&state.file, wavBuffer, size+8, &read) : FR_DENIED);
+      if (result == FR_OK && read == size+8) {
+        state.codec = ((uint16_t *)wavBuffer)[0];
+        state.freq = ((uint16_t *)wavBuffer)[2];
+        uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
+        uint32_t size = wavSamplesPtr[1];
+        if (state.freq != 0 && state.freq * (AUDIO_SAMPLE_RATE / state.freq) == AUDIO_SAMPLE_RATE) {
+          state.resampleRatio = (AUDIO_SAMPLE_RATE / state.freq);
+          state.readSize = (state.codec == CODEC_ID_PCM_S16LE ? 2*AUDIO_BUFFER_SIZE : AUDIO_BUFFER_SIZE) / state.resampleRatio;
         }
         else {
           result = FR_DENIED;
         }
+        while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
+          result = f_lseek(&state.file, f_tell(&state.file)+size);
+          if (result == FR_OK) {
+            result = f_read(&state.file, wavBuffer, 8, &read);
+            if (read != 8) result = FR_DENIED;
+            wavSamplesPtr = (uint32_t *)wavBuffer;
+            size = wavSamplesPtr[1];
+          }
+        }
+        state.size = size;
       }
       else {
         result = FR_DENIED;
       }
     }
+    else {
+      result = FR_DENIED;
+    }
+    if (result != FR_OK) {
+      f_close(&state.file);
+    }
   }
+  return result;
+}
 
-  if (result == FR_OK) {
+#if defined(AUDIO_PREFETCH)
+WavPrefetch wavPrefetch __DMA;
+
+bool WavPrefetch::isDone(const char * filename, uint8_t generation) const
+{
+  return fileGeneration == generation && !strcmp(file, filename);
+}
+
+void WavPrefetch::prefetch(const char * filename, uint8_t generation)
+{
+  if (ready) {
+    f_close(&state.file);
+    ready = false;
+  }
+
+  // remembered even if it fails, so that a missing file is tried only once
+  strcpy(file, filename);
+  fileGeneration = generation;
+
+  TRACE_EVENT_SCOPE(trace_audio_prefetch);
+  if (openWavFile(state, filename) == FR_OK) {
     read = 0;
-    result = f_read(&state.file, wavBuffer, state.readSize, &read);
+    if (f_read(&state.file, data, state.readSize, &read) == FR_OK) {
+      ready = true;
+    }
+    else {
+      f_close(&state.file);
+    }
+  }
+}
+
+bool WavPrefetch::take(const char * filename, WavState & state, uint8_t * data, UINT & read)
+{
+  if (!ready || !isDone(filename, generation)) {
+    return false;
+  }
+
+  // the file is now owned by the caller
+  state = this->state;
+  memcpy(data, this->data, this->read);
+  read = this->read;
+  ready = false;
+  file[0] = '\0';
+  return true;
+}
+#endif
+
+int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
+{
+  FRESULT result = FR_OK;
+  UINT read = 0;
+  bool prefetched = false;
+
+  if (fragment.file[1]) {
+#if defined(AUDIO_PREFETCH)
+    prefetched = wavPrefetch.take(fragment.file, state, wavBuffer, read);
+#endif
+    if (!prefetched) {
+      result = openWavFile(state, fragment.file);
+    }
+    fragment.file[1] = 0;
+  }
+
+  if (result == FR_OK) {
+    if (!prefetched) {
+      read = 0;
+      result = f_read(&state.file, wavBuffer, state.readSize, &read);
+    }
     if (result == FR_OK) {
       if (read > state.size) {
         read = state.size;
@@ -811,8 +975,34 @@ void AudioQueue::wakeup()
     audioConsumeCurrentBuffer();
     DEBUG_TIMER_STOP(debugTimerAudioConsume);
   }
+
+#if defined(AUDIO_PREFETCH)
+  // the buffers are full, time to open the next file of the queue
+  prefetchNextFile();
+#endif
 }
 
+#if defined(AUDIO_PREFETCH)
+void AudioQueue::prefetchNextFile()
+{
+  char filename[AUDIO_FILENAME_MAXLEN+1];
+  uint8_t generation;
+
+  RTOS_LOCK_MUTEX(audioMutex);
+  const AudioFragment * fragment = fragmentsFifo.peek();
+  bool found = fragment && fragment->type == FRAGMENT_FILE;
+  if (found) {
+    strcpy(filename, fragment->file);
+  }
+  generation = wavPrefetch.getGeneration();
+  RTOS_UNLOCK_MUTEX(audioMutex);
+
+  if (found && !wavPrefetch.isDone(filename, generation)) {
+    wavPrefetch.prefetch(filename, generation);
+  }
+}
+#endif
+
 inline unsigned int getToneLength(uint16_t len)
 {
   unsigned int result = len; // default
@@ -949,6 +1139,9 @@ void AudioQueue::flush()
   fragmentsFifo.clear();
   varioContext.clear();
   backgroundContext.clear();
+#if defined(AUDIO_PREFETCH)
+  wavPrefetch.invalidate();
+#endif
   RTOS_UNLOCK_MUTEX(audioMutex);
 }
 
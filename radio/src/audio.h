@@ -218,6 +218,44 @@ class ToneContext {
 
 };
 
+struct WavState {
+  FIL      file;
+  uint8_t  codec;
+  uint32_t freq;
+  uint32_t size;
+  uint8_t  resampleRatio;
+  uint16_t readSize;
+};
+
+#if defined(SDCARD) && defined(SDRAM)
+  #define AUDIO_PREFETCH
+#endif
+
+#if defined(AUDIO_PREFETCH)
+// The next prompt file of the queue, opened and with its first block already
+// read while the audio buffers are full, so that it starts without waiting for
+// the SD card (numbers and units of a PLAY_VALUE are played back-to-back)
+class WavPrefetch {
+  public:
+    void prefetch(const char * filename, uint8_t generation);
+    bool take(const char * filename, WavState & state, uint8_t * data, UINT & read);
+    bool isDone(const char * filename, uint8_t generation) const;
+
+    // the queue has been flushed, what has been prefetched is not used anymore
+    void invalidate() { generation++; }
+    uint8_t getGeneration() const { return generation; }
+
+  private:
+    volatile uint8_t generation = 0;
+    uint8_t fileGeneration = 0;
+    bool ready = false;
+    char file[AUDIO_FILENAME_MAXLEN+1] = "";
+    WavState state;
+    UINT read = 0;
+    uint8_t data[AUDIO_BUFFER_SIZE*2];
+};
+#endif
+
 class WavContext {
   public:
 
@@ -240,15 +278,7 @@ class WavContext {
 
   private:
     AudioFragment fragment;
-
-    struct {
-      FIL      file;
-      uint8_t  codec;
-      uint32_t freq;
-      uint32_t size;
-      uint8_t  resampleRatio;
-      uint16_t readSize;
-    } state;
+    WavState state;
 };
 
 class MixedContext {
@@ -471,6 +501,12 @@ class AudioFragmentFifo
       widx = ridx;                      // clean the queue
     }
 
+    // the next fragment, without removing it from the queue
+    const AudioFragment * peek() const
+    {
+      return empty() ? nullptr : &fragments[ridx];
+    }
+
     const AudioFragment * get()
     {
       if (!empty()) {
@@ -530,6 +566,10 @@ class AudioQueue {
     ToneContext  priorityContext;
     ToneContext  varioContext;
     AudioFragmentFifo fragmentsFifo;
+
+#if defined(AUDIO_PREFETCH)
+    void prefetchNextFile();
+#endif
 };
 
 extern uint8_t currentSpeakerVolume;
@@ -654,6 +694,7 @@ char * getAudioPath(char * path);
 
 void referenceSystemAudioFiles();
 void referenceModelAudioFiles();
+bool referenceModelAudioFile(const char * filename);
 
 bool isAudioFileReferenced(uint32_t i, char * filename/*at least AUDIO_FILENAME_MAXLEN+1 long*/);
 
@@ -36,6 +36,7 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "mixer_scheduler.h"
 
 #include "cli.h"
 
@@ -858,6 +859,16 @@ int cliStackInfo(const char ** argv)
   return 0;
 }
 
+int cliTasks(const char ** argv)
+{
+  for (uint8_t i = 0; i < TASK_COUNT; i++) {
+    uint16_t load = getTaskCpuLoad(i);
+    cliSerialPrint("[%s] cpu %d.%d%%, %" PRIu32 " bytes stack available", getTaskName(i),
+                   load / 10, load % 10, getTaskStackAvailable(i));
+  }
+  return 0;
+}
+
 extern int _end;
 extern int _heap_end;
 extern unsigned char *heap;
@@ -972,6 +983,21 @@ int cliSet(const char **argv)
     }
   }
 #endif
+  else if (!strcmp(argv[1], "mixerdefer")) {
+    if (!strcmp(argv[2], "on")) {
+      g_eeGeneral.mixerDeferOnOverrun = 1;
+      storageDirty(EE_GENERAL);
+    }
+    else if (!strcmp(argv[2], "off")) {
+      g_eeGeneral.mixerDeferOnOverrun = 0;
+      storageDirty(EE_GENERAL);
+    }
+    else {
+      cliSerialPrint("%s: Invalid argument \"%s\" \"%s\"", argv[0], argv[1],
+                  argv[2]);
+      return -1;
+    }
+  }
   else if (!strcmp(argv[1], "rfmod")) {
     int module = 0;
     if (toInt(argv, 2, &module) < 0) {
@@ -1225,6 +1251,20 @@ void printDebugTimers()
 }
 #endif
 
+#if defined(DEBUG_TRACE_BUFFER)
+void printTraceBuffer()
+{
+  cliSerialPrint(TRACE_BUFFER_HEADER_FORMAT, (unsigned)getTraceTicksPerUs());
+  for (uint16_t i = 0; i < TRACE_BUFFER_LEN; i++) {
+    const struct TraceElement * te = getTraceElement(i);
+    if (!te) break;
+    cliSerialPrint(TRACE_ELEMENT_FORMAT, (unsigned)te->time, te->type,
+                   te->event, (unsigned)te->data);
+  }
+  cliSerialPrint(TRACE_BUFFER_FOOTER);
+}
+#endif
+
 #if defined(DEBUG_AUDIO)
 void printAudioVars()
 {
@@ -1369,11 +1409,38 @@ int cliDisplay(const char ** argv)
     printDebugTimers();
   }
 #endif
+#if defined(DEBUG_TRACE_BUFFER)
+  else if (!strcmp(argv[1], "trace")) {
+#if defined(SDCARD)
+    if (argv[2] && !strcmp(argv[2], "save")) {
+      const char * error = writeTraceBuffer();
+      cliSerialPrint("%s: %s", argv[0], error ? error : LOGS_PATH "/trace.txt");
+    }
+    else
+#endif
+    printTraceBuffer();
+  }
+#endif
 #if defined(DEBUG_AUDIO)
   else if (!strcmp(argv[1], "audio")) {
     printAudioVars();
   }
 #endif
+  else if (!strcmp(argv[1], "storage")) {
+    cliSerialPrint("Storage write latency: %" PRIu32 "ms, max %" PRIu32 "ms",
+                   storageLastLatency10ms * 10, storageMaxLatency10ms * 10);
+  }
+  else if (!strcmp(argv[1], "mixer")) {
+    static const char * const bins[MIXER_DURATION_BINS] = { "<25%", "<50%", "<75%", "<100%", "late" };
+    cliSerialPrint("Mixer period: %dus, max duration: %dus", getMixerSchedulerPeriod(), maxMixerDuration / 2);
+    for (uint8_t i = 0; i < MIXER_DURATION_BINS; i++) {
+      cliSerialPrint("[%s] %d", bins[i], mixerTimingStats.histogram[i]);
+    }
+    cliSerialPrint("Deferred updates: %d (%s)", mixerTimingStats.deferredUpdates, g_eeGeneral.mixerDeferOnOverrun ? "on" : "off");
+    if (argv[2] && !strcmp(argv[2], "reset")) {
+      mixerTimingStats.reset();
+    }
+  }
 #if defined(DISK_CACHE)
   else if (!strcmp(argv[1], "dc")) {
     DiskCacheStats stats = diskCache.getStats();
@@ -1625,6 +1692,7 @@ const CliCommand cliCommands[] = {
   { "print", cliDisplay, "<address> [<size>] | <what>" },
   { "p", cliDisplay, "<address> [<size>] | <what>" },
   { "stackinfo", cliStackInfo, "" },
+  { "tasks", cliTasks, "" },
   { "meminfo", cliMemoryInfo, "" },
   { "test", cliTest, "new | graphics | memspd" },
   { "trace", cliTrace, "on | off" },
@@ -19,6 +19,8 @@
  * GNU General Public License for more details.
  */
 
+#include <atomic>
+
 #include "opentx.h"
 
 #if defined(LIBOPENUI)
@@ -31,6 +33,30 @@ constexpr int CUSTOM_CURVE_POINTS(int p) { return 2 * p + (2 * DEFAULT_POINTS -
 
 int8_t * curveEnd[MAX_CURVES];
 
+#if defined(SDRAM)
+  // radios with spare RAM keep the smooth curves tangents (~3.5KB)
+  #define CURVE_CACHE
+#endif
+
+#if defined(CURVE_CACHE)
+// Tangents of smooth curves, computed once per curve. Each entry keeps a copy
+// of the curve it was computed for: any change to the curve data (menus, Lua,
+// model load...) is detected on the next evaluation and the entry rebuilt.
+//
+// Curves are evaluated from the mixer and UI tasks: entries are rewritten
+// with interrupts disabled and a new generation, and a reader which sees the
+// generation change computes the value again without the cache.
+struct CurveCache {
+  volatile uint32_t generation;
+  CurveHeader header;
+  bool valid;
+  int8_t points[CUSTOM_CURVE_POINTS(MAX_POINTS_PER_CURVE - DEFAULT_POINTS)];
+  int32_t tangents[MAX_POINTS_PER_CURVE];
+};
+
+static CurveCache curveCache[MAX_CURVES];
+#endif
+
 uint8_t getCurvePoints(uint8_t index)
 {
   if (index >= MAX_CURVES)
@@ -74,6 +100,11 @@ void loadCurves()
     curveEnd[i] = tmp;
 
   }
+#if defined(CURVE_CACHE)
+  for (auto & cache : curveCache) {
+    cache.valid = false;
+  }
+#endif
   if (showWarning) {
     POPUP_WARNING("Invalid curve data repaired", "check your curves, logic switches");
   }
@@ -228,6 +259,122 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
   return m;
 }
 
+static int32_t hermite_segment(int32_t x, int32_t p0x, int32_t p0y, int32_t m0,
+                               int32_t p3x, int32_t p3y, int32_t m3)
+{
+  int32_t y;
+  int32_t h = p3x - p0x;
+  int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
+  int32_t t2 = t * t / MMULT;
+  int32_t t3 = t2 * t / MMULT;
+  int32_t h00 = 2*t3 - 3*t2 + MMULT;
+  int32_t h10 = t3 - 2*t2 + t;
+  int32_t h01 = -2*t3 + 3*t2;
+  int32_t h11 = t3 - t2;
+  y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
+  y /= MMULT;
+  return y;
+}
+
+#if defined(CURVE_CACHE)
+static int32_t getCurvePointX(const int8_t * points, uint8_t count, bool custom, int i)
+{
+  if (i <= 0)
+    return -RESX;
+  else if (i >= count - 1)
+    return RESX;
+  else if (custom)
+    return calc100toRESX(points[count + i - 1]);
+  else
+    return -RESX + (i * 2 * RESX) / (count - 1);
+}
+
+// returns i so that x is in the [i, i+1] segment, X must be in increasing order
+static int findCurveSegment(int x, const int8_t * points, uint8_t count, bool custom)
+{
+  int lo = 0;
+  int hi = count - 2;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (x <= getCurvePointX(points, count, custom, mid + 1))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+static bool isCurveMonotonic(const int8_t * points, uint8_t count, bool custom)
+{
+  if (!custom)
+    return true;
+  for (int i = 0; i < count - 1; i++) {
+    if (getCurvePointX(points, count, custom, i) > getCurvePointX(points, count, custom, i + 1))
+      return false;
+  }
+  return true;
+}
+
+// nullptr if the curve cannot be looked up by bisection (custom X points
+// not in increasing order): the linear scan is used then
+static const CurveCache * getCurveCache(uint8_t idx)
+{
+  const CurveHeader & crv = g_model.curves[idx];
+  const int8_t * points = curveAddress(idx);
+  uint8_t count = STD_CURVE_POINTS(crv.points);
+  uint8_t size = getCurvePoints(idx);
+
+  if (count < 2 || count > MAX_POINTS_PER_CURVE)
+    return nullptr;
+
+  CurveCache & cache = curveCache[idx];
+  if (cache.valid && cache.header.type == crv.type &&
+      cache.header.smooth == crv.smooth && cache.header.points == crv.points &&
+      !memcmp(cache.points, points, size))
+    return &cache;
+
+  CurveCache update;
+  update.header = crv;
+  memcpy(update.points, points, size);
+  if (!isCurveMonotonic(update.points, count, crv.type == CURVE_TYPE_CUSTOM))
+    return nullptr;
+  for (int i = 0; i < count; i++) {
+    update.tangents[i] = compute_tangent(&update.header, update.points, i);
+  }
+  update.valid = true;
+
+  __disable_irq();
+  update.generation = cache.generation + 1;
+  cache = update;
+  __enable_irq();
+
+  return &cache;
+}
+
+static bool cachedHermiteSpline(int16_t x, uint8_t idx, int32_t & y)
+{
+  const CurveCache * cache = getCurveCache(idx);
+  if (!cache)
+    return false;
+
+  uint32_t generation = cache->generation;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+
+  uint8_t count = STD_CURVE_POINTS(cache->header.points);
+  bool custom = (cache->header.type == CURVE_TYPE_CUSTOM);
+  const int8_t * points = cache->points;
+  int i = findCurveSegment(x, points, count, custom);
+  y = hermite_segment(x, getCurvePointX(points, count, custom, i),
+                      calc100toRESX(points[i]), cache->tangents[i],
+                      getCurvePointX(points, count, custom, i + 1),
+                      calc100toRESX(points[i + 1]), cache->tangents[i + 1]);
+
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  // false if the entry was rewritten meanwhile
+  return cache->generation == generation;
+}
+#endif
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
@@ -235,16 +382,22 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
 */
 int16_t hermite_spline(int16_t x, uint8_t idx)
 {
-  CurveHeader &crv = g_model.curves[idx];
-  int8_t *points = curveAddress(idx);
-  uint8_t count = STD_CURVE_POINTS(crv.points);
-  bool custom = (crv.type == CURVE_TYPE_CUSTOM);
-
   if (x < -RESX)
     x = -RESX;
   else if (x > RESX)
     x = RESX;
 
+#if defined(CURVE_CACHE)
+  int32_t y;
+  if (cachedHermiteSpline(x, idx, y))
+    return y;
+#endif
+
+  CurveHeader &crv = g_model.curves[idx];
+  int8_t *points = curveAddress(idx);
+  uint8_t count = STD_CURVE_POINTS(crv.points);
+  bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+
   for (int i=0; i<count-1; i++) {
     int32_t p0x, p3x;
     if (custom) {
@@ -257,22 +410,10 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
     }
 
     if (x >= p0x && x <= p3x) {
-      int32_t p0y = calc100toRESX(points[i]);
-      int32_t p3y = calc100toRESX(points[i+1]);
-      int32_t m0 = compute_tangent(&crv, points, i);
-      int32_t m3 = compute_tangent(&crv, points, i+1);
-      int32_t y;
-      int32_t h = p3x - p0x;
-      int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
-      int32_t t2 = t * t / MMULT;
-      int32_t t3 = t2 * t / MMULT;
-      int32_t h00 = 2*t3 - 3*t2 + MMULT;
-      int32_t h10 = t3 - 2*t2 + t;
-      int32_t h01 = -2*t3 + 3*t2;
-      int32_t h11 = t3 - t2;
-      y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
-      y /= MMULT;
-      return y;
+      return hermite_segment(x, p0x, calc100toRESX(points[i]),
+                             compute_tangent(&crv, points, i), p3x,
+                             calc100toRESX(points[i+1]),
+                             compute_tangent(&crv, points, i+1));
     }
   }
   return 0;
@@ -296,11 +437,20 @@ int intpol(int x, uint8_t idx) // -100, -75, -50, -25, 0 ,25 ,50, 75, 100
     uint16_t a = 0, b = 0;
     uint8_t i;
     if (custom) {
-      for (i = 0; i < count - 1; i++) {
-        a = b;
-        b = (i == count - 2 ? 2 * RESX
-                            : RESX + calc100toRESX(points[count + i]));
-        if ((uint16_t)x <= b) break;
+#if defined(CURVE_CACHE)
+      if (getCurveCache(idx)) {
+        i = findCurveSegment(x - RESX, points, count, true);
+        a = RESX + getCurvePointX(points, count, true, i);
+        b = RESX + getCurvePointX(points, count, true, i + 1);
+      } else
+#endif
+      {
+        for (i = 0; i < count - 1; i++) {
+          a = b;
+          b = (i == count - 2 ? 2 * RESX
+                              : RESX + calc100toRESX(points[count + i]));
+          if ((uint16_t)x <= b) break;
+        }
       }
     } else {
       uint16_t d = (RESX * 2) / (count - 1);
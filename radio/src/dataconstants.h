@@ -591,6 +591,7 @@ enum Functions {
 #if defined(COLORLCD)
   FUNC_DISABLE_TOUCH,
   FUNC_SET_SCREEN,
+  FUNC_SCREEN_RECORD,
 #endif
 #if defined(DEBUG)
   FUNC_TEST,  // should remain the last before MAX as not added in Companion
@@ -524,6 +524,8 @@ PACK(struct ModuleData {
     } ghost);
     NOBACKUP(struct {
       uint8_t telemetryBaudrate:3;
+      uint8_t subsetChannels:1;
+      uint8_t spare:4 SKIP;
     } crsf);
     NOBACKUP(struct {
       uint8_t flags;
@@ -868,7 +870,7 @@ PACK(struct RadioData {
   int8_t antennaMode:2 ENUM(AntennaModes);
   uint8_t disableRtcWarning:1;
   uint8_t keysBacklight:1;
-  uint8_t spare1:1 SKIP;
+  uint8_t mixerDeferOnOverrun:1;
   uint8_t internalModule ENUM(ModuleType);
   NOBACKUP(TrainerData trainer);
   NOBACKUP(uint8_t view);            // index of view in main screen
@@ -118,6 +118,112 @@ void debugPrintf(const char * format, ...)
 struct InterruptCounters interruptCounters;
 #endif //#if defined(DEBUG_INTERRUPTS)
 
+#if defined(DEBUG_TRACE_BUFFER)
+
+#if defined(SIMU)
+#include <chrono>
+#endif
+
+static_assert((TRACE_BUFFER_LEN & (TRACE_BUFFER_LEN - 1)) == 0, "TRACE_BUFFER_LEN must be a power of 2");
+
+static struct TraceElement traceBuffer[TRACE_BUFFER_LEN];
+static uint32_t traceIndex = 0;
+
+static inline uint32_t traceTicks()
+{
+#if defined(SIMU)
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+  return ticksNow();
+#endif
+}
+
+uint32_t getTraceTicksPerUs()
+{
+#if defined(SIMU)
+  return 1;
+#else
+  return SYSTEM_TICKS_1US;
+#endif
+}
+
+// Lock free: each writer (task or interrupt) claims its own slot,
+// the oldest elements are overwritten
+void trace_record(uint8_t type, enum TraceEvent event, uint32_t data)
+{
+  uint32_t idx = __atomic_fetch_add(&traceIndex, 1, __ATOMIC_RELAXED);
+  struct TraceElement * te = &traceBuffer[idx & (TRACE_BUFFER_LEN - 1)];
+  te->time = traceTicks();
+  te->type = type;
+  te->event = event;
+  te->data = data;
+}
+
+void trace_event(enum TraceEvent event, uint32_t data)
+{
+  trace_record(TRACE_TYPE_INSTANT, event, data);
+}
+
+void trace_event_i(enum TraceEvent event, uint32_t data)
+{
+  trace_record(TRACE_TYPE_INSTANT, event, data);
+}
+
+// idx 0 is the oldest element still in the buffer
+const struct TraceElement * getTraceElement(uint16_t idx)
+{
+  uint32_t count = traceIndex;
+  uint32_t first = count > TRACE_BUFFER_LEN ? count - TRACE_BUFFER_LEN : 0;
+  if (idx >= count - first) {
+    return nullptr;
+  }
+  return &traceBuffer[(first + idx) & (TRACE_BUFFER_LEN - 1)];
+}
+
+// Same format as "print trace" on the CLI, see radio/util/trace2json.py
+void dumpTraceBuffer()
+{
+  TRACE_NOCRLF(TRACE_BUFFER_HEADER_FORMAT CRLF, (unsigned)getTraceTicksPerUs());
+  for (uint16_t i = 0; i < TRACE_BUFFER_LEN; i++) {
+    const struct TraceElement * te = getTraceElement(i);
+    if (!te) break;
+    TRACE_NOCRLF(TRACE_ELEMENT_FORMAT CRLF, (unsigned)te->time, te->type,
+                 te->event, (unsigned)te->data);
+  }
+  TRACE_NOCRLF(TRACE_BUFFER_FOOTER CRLF);
+}
+
+#if defined(SDCARD)
+const char * writeTraceBuffer()
+{
+  FIL file;
+  const char * error = sdCheckAndCreateDirectory(LOGS_PATH);
+  if (error) {
+    return error;
+  }
+
+  FRESULT result = f_open(&file, LOGS_PATH "/trace.txt", FA_CREATE_ALWAYS | FA_WRITE);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  f_printf(&file, TRACE_BUFFER_HEADER_FORMAT "\n", (unsigned)getTraceTicksPerUs());
+  for (uint16_t i = 0; i < TRACE_BUFFER_LEN; i++) {
+    const struct TraceElement * te = getTraceElement(i);
+    if (!te) break;
+    f_printf(&file, TRACE_ELEMENT_FORMAT "\n", (unsigned)te->time, te->type,
+             te->event, (unsigned)te->data);
+  }
+  f_printf(&file, TRACE_BUFFER_FOOTER "\n");
+
+  result = f_close(&file);
+  return result == FR_OK ? nullptr : SDCARD_ERROR(result);
+}
+#endif
+
+#endif // #if defined(DEBUG_TRACE_BUFFER)
+
 #if defined(DEBUG_TIMERS)
 
 void DebugTimer::start()
@@ -178,7 +284,11 @@ const char * const debugTimerNames[DEBUG_TIMERS_COUNT] = {
   ,"Audio int. "   // debugTimerAudioIterval
   ,"Audio dur. "   // debugTimerAudioDuration
   ," A. consume"   // debugTimerAudioConsume
-  ,"SpaceMouse "   // debugTimerSpaceMouseWakeup
+  ,"YAML scan  "   // debugTimerYamlScan
+  ,"Storage wr."   // debugTimerStorageWrite
+#if defined(SPACEMOUSE)
+  ,"SpaceMouse "   // debugTimerSpacemouseWakeup
+#endif
 };
 
 #endif
@@ -100,7 +100,14 @@ EXTERN_C(extern volatile uint32_t g_tmr10ms);
 
 #if defined(DEBUG_TRACE_BUFFER)
 
-#define TRACE_BUFFER_LEN  50
+// must be a power of 2
+#if !defined(TRACE_BUFFER_LEN)
+#if defined(COLORLCD)
+#define TRACE_BUFFER_LEN  1024
+#else
+#define TRACE_BUFFER_LEN  128
+#endif
+#endif
 
 enum TraceEvent {
   trace_start = 1,
@@ -140,33 +147,91 @@ enum TraceEvent {
   ff_f_write_move_window,
 
   audio_getNextFilledBuffer_skip = 60,
+
+  // durations (begin / end)
+  trace_mixer = 80,
+  trace_pulses,
+  trace_telemetry,
+  trace_audio,
+  trace_menus,
+  trace_lua,
+  trace_lvgl,
+  trace_storage_write,
+  trace_sd_read,
+  trace_sd_write,
+  trace_audio_prefetch,
+};
+
+enum TraceEventType {
+  TRACE_TYPE_INSTANT = 'i',
+  TRACE_TYPE_BEGIN = 'B',
+  TRACE_TYPE_END = 'E',
 };
 
 struct TraceElement {
-  gtime_t time;
-  uint8_t time_ms;
-  enum TraceEvent event;
+  uint32_t time;      // CPU cycles counter (wraps around)
+  uint8_t type;       // TraceEventType
+  uint8_t event;      // TraceEvent
   uint32_t data;
 };
 
 #if defined(__cplusplus)
 extern "C" {
 #endif
+void trace_record(uint8_t type, enum TraceEvent event, uint32_t data);
 void trace_event(enum TraceEvent event, uint32_t data);
 void trace_event_i(enum TraceEvent event, uint32_t data);
 const struct TraceElement * getTraceElement(uint16_t idx);
+uint32_t getTraceTicksPerUs();
 void dumpTraceBuffer();
 #if defined(__cplusplus)
 }
 #endif
 
+#if defined(SDCARD) && defined(__cplusplus)
+// writes the buffer to /LOGS/trace.txt
+const char * writeTraceBuffer();
+#endif
+
+// text dump of the buffer, converted by radio/util/trace2json.py
+#define TRACE_BUFFER_HEADER_FORMAT  "trace buffer: %u ticks/us"
+#define TRACE_ELEMENT_FORMAT        "%u,%c,%u,0x%08x"
+#define TRACE_BUFFER_FOOTER         "trace end"
+
 #define TRACE_EVENT(condition, event, data)   if (condition) { trace_event(event, data); }
 #define TRACEI_EVENT(condition, event, data)  if (condition) { trace_event_i(event, data); }
+#define TRACE_EVENT_BEGIN(event)              trace_record(TRACE_TYPE_BEGIN, event, 0)
+#define TRACE_EVENT_END(event)                trace_record(TRACE_TYPE_END, event, 0)
+
+#if defined(__cplusplus)
+class TraceScope
+{
+  public:
+    explicit TraceScope(enum TraceEvent event):
+      event(event)
+    {
+      TRACE_EVENT_BEGIN(event);
+    }
+
+    ~TraceScope()
+    {
+      TRACE_EVENT_END(event);
+    }
+
+  protected:
+    enum TraceEvent event;
+};
+
+#define TRACE_EVENT_SCOPE(event)              TraceScope traceScope(event)
+#endif
 
 #else  // #if defined(DEBUG_TRACE_BUFFER)
 
 #define TRACE_EVENT(condition, event, data)
 #define TRACEI_EVENT(condition, event, data)
+#define TRACE_EVENT_BEGIN(event)
+#define TRACE_EVENT_END(event)
+#define TRACE_EVENT_SCOPE(event)
 
 #endif // #if defined(DEBUG_TRACE_BUFFER)
 
@@ -390,6 +455,7 @@ enum DebugTimers {
   debugTimerAudioDuration,
   debugTimerAudioConsume,
   debugTimerYamlScan,
+  debugTimerStorageWrite,
 
 #if defined(SPACEMOUSE)
   debugTimerSpacemouseWakeup,
@@ -171,11 +171,13 @@ int DiskCache::getHitRate() const
 
 DRESULT disk_read(BYTE drv, BYTE * buff, DWORD sector, UINT count)
 {
+  TRACE_EVENT_SCOPE(trace_sd_read);
   return diskCache.read(drv, buff, sector, count);
 }
 
 
 DRESULT disk_write(BYTE drv, const BYTE * buff, DWORD sector, UINT count)
 {
+  TRACE_EVENT_SCOPE(trace_sd_write);
   return diskCache.write(drv, buff, sector, count);
 }
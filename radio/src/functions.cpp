@@ -126,338 +126,494 @@ bool isRepeatDelayElapsed(const CustomFunctionData * functions, CustomFunctionsC
   }
 }
 
-#define VOLUME_HYSTERESIS 10            // how much must a input value change to actually be considered for new volume setting
-getvalue_t requiredSpeakerVolumeRawLast = 1024 + 1; //initial value must be outside normal range
-
-void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
+// Functions which only act when their switch changes or when their repeat
+// period elapses. The others are level triggered and evaluated at each tick.
+static bool isTriggeredFunction(const CustomFunctionData * cfn)
 {
-  MASK_FUNC_TYPE newActiveFunctions  = 0;
-  MASK_CFN_TYPE  newActiveSwitches = 0;
+  switch (CFN_FUNC(cfn)) {
+#if defined(SDCARD)
+    case FUNC_PLAY_SOUND:
+    case FUNC_PLAY_TRACK:
+    case FUNC_PLAY_VALUE:
+#if defined(HAPTIC)
+    case FUNC_HAPTIC:
+#endif
+#endif
+    case FUNC_SCREENSHOT:
+#if defined(COLORLCD)
+    case FUNC_SET_SCREEN:
+#endif
+      return true;
 
-  uint8_t playFirstIndex = (functions == g_model.customFn ? 1 : 1+MAX_SPECIAL_FUNCTIONS);
-  #define PLAY_INDEX   (i+playFirstIndex)
+    case FUNC_RESET:
+      // timers and telemetry are held reset while the switch is ON
+      return CFN_PARAM(cfn) == FUNC_RESET_FLIGHT;
 
-#if defined(OVERRIDE_CHANNEL_FUNCTION)
-  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
-    safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+    default:
+      return false;
   }
-#endif
+}
 
-#if defined(GVARS)
-  for (uint8_t i=0; i<MAX_TRIMS; i++) {
-    trimGvar[i] = -1;
-  }
-#endif
+static uint8_t getFunctionSwitchFlags(const CustomFunctionData * cfn)
+{
+  return IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0;
+}
+
+// Splits the functions which have a switch into the level triggered ones and
+// the triggered ones, the latter being grouped by switch
+static void compileFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
+{
+  functionsContext.levelCount = 0;
+  functionsContext.triggerCount = 0;
+  functionsContext.groupCount = 0;
+  functionsContext.triggerMask = 0;
+  functionsContext.groupActive = 0;
+  functionsContext.groupRepeat = 0;
 
   for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
     const CustomFunctionData * cfn = &functions[i];
-    swsrc_t swtch = CFN_SWITCH(cfn);
-    if (swtch) {
-      MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
-
-      bool active = getSwitch(
-          swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
+    if (!CFN_SWITCH(cfn))
+      continue;
+    if (isTriggeredFunction(cfn))
+      functionsContext.triggerMask |= ((MASK_CFN_TYPE)1 << i);
+    else
+      functionsContext.level[functionsContext.levelCount++] = i;
+  }
 
-      if (HAS_ENABLE_PARAM(CFN_FUNC(cfn))) {
-        active &= (bool)CFN_ACTIVE(cfn);
+  MASK_CFN_TYPE pending = functionsContext.triggerMask;
+  for (uint8_t i=0; pending; i++) {
+    if (!(pending & ((MASK_CFN_TYPE)1 << i)))
+      continue;
+    const CustomFunctionData * cfn = &functions[i];
+    functionsContext.groupStart[functionsContext.groupCount++] = functionsContext.triggerCount;
+    for (uint8_t j=i; j<MAX_SPECIAL_FUNCTIONS; j++) {
+      MASK_CFN_TYPE mask = ((MASK_CFN_TYPE)1 << j);
+      if ((pending & mask) &&
+          CFN_SWITCH(&functions[j]) == CFN_SWITCH(cfn) &&
+          getFunctionSwitchFlags(&functions[j]) == getFunctionSwitchFlags(cfn)) {
+        functionsContext.trigger[functionsContext.triggerCount++] = j;
+        pending &= ~mask;
       }
+    }
+  }
+  functionsContext.groupStart[functionsContext.groupCount] = functionsContext.triggerCount;
+
+  functionsContext.compiled = true;
+}
+
+// Returns false when the function will not repeat while its switch stays ON
+static bool getRepeatDeadline(const CustomFunctionData * cfn, tmr10ms_t lastFunctionTime, tmr10ms_t & deadline)
+{
+  if (!HAS_REPEAT_PARAM(CFN_FUNC(cfn)))
+    return false;
+
+  uint8_t repeatParam = CFN_PLAY_REPEAT(cfn);
+  if (!lastFunctionTime || (repeatParam == CFN_PLAY_REPEAT_NOSTART && !IS_SILENCE_PERIOD_ELAPSED())) {
+    deadline = get_tmr10ms();
+    return true;
+  }
+
+  if (repeatParam && repeatParam != CFN_PLAY_REPEAT_NOSTART) {
+    deadline = lastFunctionTime + 100*repeatParam;
+    return true;
+  }
+
+  return false;
+}
+
+#define VOLUME_HYSTERESIS 10            // how much must a input value change to actually be considered for new volume setting
+getvalue_t requiredSpeakerVolumeRawLast = 1024 + 1; //initial value must be outside normal range
+
+static void evalFunction(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext, uint8_t i, bool active,
+                         MASK_FUNC_TYPE & newActiveFunctions, MASK_CFN_TYPE & newActiveSwitches)
+{
+  const CustomFunctionData * cfn = &functions[i];
+  MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
 
-      if (active) {
-        switch (CFN_FUNC(cfn)) {
+  uint8_t playFirstIndex = (functions == g_model.customFn ? 1 : 1+MAX_SPECIAL_FUNCTIONS);
+  #define PLAY_INDEX   (i+playFirstIndex)
+
+  if (active) {
+    switch (CFN_FUNC(cfn)) {
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
-          case FUNC_OVERRIDE_CHANNEL:
-            safetyCh[CFN_CH_INDEX(cfn)] = CFN_PARAM(cfn);
-            break;
+      case FUNC_OVERRIDE_CHANNEL:
+        safetyCh[CFN_CH_INDEX(cfn)] = CFN_PARAM(cfn);
+        break;
 #endif
 
-          case FUNC_TRAINER: {
-            uint8_t param = CFN_CH_INDEX(cfn);
-            if (param == 0)
-              newActiveFunctions |= 0x0F;
-            else if (param <= MAX_STICKS)
-              newActiveFunctions |= (1 << (param - 1));
-            else if (param == MAX_STICKS + 1)
-              newActiveFunctions |= (1u << FUNCTION_TRAINER_CHANNELS);
-            break;
-          }
+      case FUNC_TRAINER: {
+        uint8_t param = CFN_CH_INDEX(cfn);
+        if (param == 0)
+          newActiveFunctions |= 0x0F;
+        else if (param <= MAX_STICKS)
+          newActiveFunctions |= (1 << (param - 1));
+        else if (param == MAX_STICKS + 1)
+          newActiveFunctions |= (1u << FUNCTION_TRAINER_CHANNELS);
+        break;
+      }
 
-          case FUNC_INSTANT_TRIM:
-            newActiveFunctions |= (1u << FUNCTION_INSTANT_TRIM);
-            if (!isFunctionActive(FUNCTION_INSTANT_TRIM)) {
-              if (IS_INSTANT_TRIM_ALLOWED()) {
-                instantTrim();
-              }
-            }
+      case FUNC_INSTANT_TRIM:
+        newActiveFunctions |= (1u << FUNCTION_INSTANT_TRIM);
+        if (!isFunctionActive(FUNCTION_INSTANT_TRIM)) {
+          if (IS_INSTANT_TRIM_ALLOWED()) {
+            instantTrim();
+          }
+        }
+        break;
+
+      case FUNC_RESET:
+        switch (CFN_PARAM(cfn)) {
+          case FUNC_RESET_TIMER1:
+          case FUNC_RESET_TIMER2:
+          case FUNC_RESET_TIMER3:
+            timerReset(CFN_PARAM(cfn));
             break;
-
-          case FUNC_RESET:
-            switch (CFN_PARAM(cfn)) {
-              case FUNC_RESET_TIMER1:
-              case FUNC_RESET_TIMER2:
-              case FUNC_RESET_TIMER3:
-                timerReset(CFN_PARAM(cfn));
-                break;
-              case FUNC_RESET_FLIGHT:
-                if (!(functionsContext.activeSwitches & switch_mask)) {
-                  mainRequestFlags |=
-                      (1 << REQUEST_FLIGHT_RESET);  // on systems with threads
-                                                    // flightReset() must not be
-                                                    // called from the mixers
-                                                    // thread!
-                }
-                break;
-              case FUNC_RESET_TELEMETRY:
-                telemetryReset();
-                break;
-            }
-            if (CFN_PARAM(cfn) >= FUNC_RESET_PARAM_FIRST_TELEM) {
-              uint8_t item = CFN_PARAM(cfn) - FUNC_RESET_PARAM_FIRST_TELEM;
-              if (item < MAX_TELEMETRY_SENSORS) {
-                telemetryItems[item].clear();
-              }
+          case FUNC_RESET_FLIGHT:
+            if (!(functionsContext.activeSwitches & switch_mask)) {
+              mainRequestFlags |=
+                  (1 << REQUEST_FLIGHT_RESET);  // on systems with threads
+                                                // flightReset() must not be
+                                                // called from the mixers
+                                                // thread!
             }
             break;
-
-          case FUNC_SET_TIMER:
-            timerSet(CFN_TIMER_INDEX(cfn), CFN_PARAM(cfn));
+          case FUNC_RESET_TELEMETRY:
+            telemetryReset();
             break;
+        }
+        if (CFN_PARAM(cfn) >= FUNC_RESET_PARAM_FIRST_TELEM) {
+          uint8_t item = CFN_PARAM(cfn) - FUNC_RESET_PARAM_FIRST_TELEM;
+          if (item < MAX_TELEMETRY_SENSORS) {
+            telemetryItems[item].clear();
+          }
+        }
+        break;
 
-          case FUNC_SET_FAILSAFE:
-            setCustomFailsafe(CFN_PARAM(cfn));
-            break;
+      case FUNC_SET_TIMER:
+        timerSet(CFN_TIMER_INDEX(cfn), CFN_PARAM(cfn));
+        break;
+
+      case FUNC_SET_FAILSAFE:
+        setCustomFailsafe(CFN_PARAM(cfn));
+        break;
 
 #if defined(DANGEROUS_MODULE_FUNCTIONS)
-          case FUNC_RANGECHECK:
-          case FUNC_BIND: {
-            unsigned int moduleIndex = CFN_PARAM(cfn);
-            if (moduleIndex < NUM_MODULES) {
-              moduleState[moduleIndex].mode =
-                  1 + CFN_FUNC(cfn) - FUNC_RANGECHECK;
-            }
-            break;
-          }
+      case FUNC_RANGECHECK:
+      case FUNC_BIND: {
+        unsigned int moduleIndex = CFN_PARAM(cfn);
+        if (moduleIndex < NUM_MODULES) {
+          moduleState[moduleIndex].mode =
+              1 + CFN_FUNC(cfn) - FUNC_RANGECHECK;
+        }
+        break;
+      }
 #endif
 
 #if defined(GVARS)
-          case FUNC_ADJUST_GVAR:
-            if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_CONSTANT) {
-              SET_GVAR(CFN_GVAR_INDEX(cfn), CFN_PARAM(cfn),
-                       mixerCurrentFlightMode);
-            } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_GVAR) {
-              SET_GVAR(CFN_GVAR_INDEX(cfn),
-                       GVAR_VALUE(CFN_PARAM(cfn),
-                                  getGVarFlightMode(mixerCurrentFlightMode,
-                                                    CFN_PARAM(cfn))),
-                       mixerCurrentFlightMode);
-            } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_INCDEC) {
-              if (!(functionsContext.activeSwitches & switch_mask)) {
-                SET_GVAR(CFN_GVAR_INDEX(cfn),
-                         limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
-                                        GVAR_VALUE(CFN_GVAR_INDEX(cfn),
-                                                   getGVarFlightMode(
-                                                       mixerCurrentFlightMode,
-                                                       CFN_GVAR_INDEX(cfn))) +
-                                            CFN_PARAM(cfn),
-                                        MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))),
-                         mixerCurrentFlightMode);
-              }
-            } else if (CFN_PARAM(cfn) >= MIXSRC_FIRST_TRIM &&
-                       CFN_PARAM(cfn) <= MIXSRC_LAST_TRIM) {
-              trimGvar[CFN_PARAM(cfn) - MIXSRC_FIRST_TRIM] =
-                  CFN_GVAR_INDEX(cfn);
-            } else {
-              SET_GVAR(CFN_GVAR_INDEX(cfn),
-                       limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
-                                      calcRESXto100(getValue(CFN_PARAM(cfn))),
-                                      MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))),
-                       mixerCurrentFlightMode);
-            }
-            break;
+      case FUNC_ADJUST_GVAR:
+        if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_CONSTANT) {
+          SET_GVAR(CFN_GVAR_INDEX(cfn), CFN_PARAM(cfn),
+                   mixerCurrentFlightMode);
+        } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_GVAR) {
+          SET_GVAR(CFN_GVAR_INDEX(cfn),
+                   GVAR_VALUE(CFN_PARAM(cfn),
+                              getGVarFlightMode(mixerCurrentFlightMode,
+                                                CFN_PARAM(cfn))),
+                   mixerCurrentFlightMode);
+        } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_INCDEC) {
+          if (!(functionsContext.activeSwitches & switch_mask)) {
+            SET_GVAR(CFN_GVAR_INDEX(cfn),
+                     limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
+                                    GVAR_VALUE(CFN_GVAR_INDEX(cfn),
+                                               getGVarFlightMode(
+                                                   mixerCurrentFlightMode,
+                                                   CFN_GVAR_INDEX(cfn))) +
+                                        CFN_PARAM(cfn),
+                                    MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))),
+                     mixerCurrentFlightMode);
+          }
+        } else if (CFN_PARAM(cfn) >= MIXSRC_FIRST_TRIM &&
+                   CFN_PARAM(cfn) <= MIXSRC_LAST_TRIM) {
+          trimGvar[CFN_PARAM(cfn) - MIXSRC_FIRST_TRIM] =
+              CFN_GVAR_INDEX(cfn);
+        } else {
+          SET_GVAR(CFN_GVAR_INDEX(cfn),
+                   limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
+                                  calcRESXto100(getValue(CFN_PARAM(cfn))),
+                                  MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))),
+                   mixerCurrentFlightMode);
+        }
+        break;
 #endif
 
-          case FUNC_VOLUME: {
-            getvalue_t raw = getValue(CFN_PARAM(cfn));
-            // only set volume if input changed more than hysteresis
-            if (abs(requiredSpeakerVolumeRawLast - raw) > VOLUME_HYSTERESIS) {
-              requiredSpeakerVolumeRawLast = raw;
-            }
-            requiredSpeakerVolume =
-                ((1024 + requiredSpeakerVolumeRawLast) * VOLUME_LEVEL_MAX) /
-                2048;
-            break;
-          }
+      case FUNC_VOLUME: {
+        getvalue_t raw = getValue(CFN_PARAM(cfn));
+        // only set volume if input changed more than hysteresis
+        if (abs(requiredSpeakerVolumeRawLast - raw) > VOLUME_HYSTERESIS) {
+          requiredSpeakerVolumeRawLast = raw;
+        }
+        requiredSpeakerVolume =
+            ((1024 + requiredSpeakerVolumeRawLast) * VOLUME_LEVEL_MAX) /
+            2048;
+        break;
+      }
 
 #if defined(SDCARD)
-          case FUNC_PLAY_SOUND:
-          case FUNC_PLAY_TRACK:
-          case FUNC_PLAY_VALUE:
+      case FUNC_PLAY_SOUND:
+      case FUNC_PLAY_TRACK:
+      case FUNC_PLAY_VALUE:
 #if defined(HAPTIC)
-          case FUNC_HAPTIC:
+      case FUNC_HAPTIC:
 #endif
-          {
-            if (isRepeatDelayElapsed(functions, functionsContext, i)) {
-              if (!IS_PLAYING(PLAY_INDEX)) {
-                if (CFN_FUNC(cfn) == FUNC_PLAY_SOUND) {
-                  AUDIO_PLAY(AU_SPECIAL_SOUND_FIRST + CFN_PARAM(cfn));
-                } else if (CFN_FUNC(cfn) == FUNC_PLAY_VALUE) {
-                  PLAY_VALUE(CFN_PARAM(cfn), PLAY_INDEX);
-                }
+      {
+        if (isRepeatDelayElapsed(functions, functionsContext, i)) {
+          if (!IS_PLAYING(PLAY_INDEX)) {
+            if (CFN_FUNC(cfn) == FUNC_PLAY_SOUND) {
+              AUDIO_PLAY(AU_SPECIAL_SOUND_FIRST + CFN_PARAM(cfn));
+            } else if (CFN_FUNC(cfn) == FUNC_PLAY_VALUE) {
+              PLAY_VALUE(CFN_PARAM(cfn), PLAY_INDEX);
+            }
 #if defined(HAPTIC)
-                else if (CFN_FUNC(cfn) == FUNC_HAPTIC) {
-                  haptic.event(AU_SPECIAL_SOUND_LAST + CFN_PARAM(cfn));
-                }
+            else if (CFN_FUNC(cfn) == FUNC_HAPTIC) {
+              haptic.event(AU_SPECIAL_SOUND_LAST + CFN_PARAM(cfn));
+            }
 #endif
-                else {
-                  playCustomFunctionFile(cfn, PLAY_INDEX);
-                }
-              }
+            else {
+              playCustomFunctionFile(cfn, PLAY_INDEX);
             }
-            break;
           }
+        }
+        break;
+      }
 
-          case FUNC_BACKGND_MUSIC:
-            if (!(newActiveFunctions & (1 << FUNCTION_BACKGND_MUSIC))) {
-              newActiveFunctions |= (1 << FUNCTION_BACKGND_MUSIC);
-              if (!IS_PLAYING(PLAY_INDEX)) {
-                playCustomFunctionFile(cfn, PLAY_INDEX);
-              }
-            }
-            break;
+      case FUNC_BACKGND_MUSIC:
+        if (!(newActiveFunctions & (1 << FUNCTION_BACKGND_MUSIC))) {
+          newActiveFunctions |= (1 << FUNCTION_BACKGND_MUSIC);
+          if (!IS_PLAYING(PLAY_INDEX)) {
+            playCustomFunctionFile(cfn, PLAY_INDEX);
+          }
+        }
+        break;
 
-          case FUNC_BACKGND_MUSIC_PAUSE:
-            newActiveFunctions |= (1 << FUNCTION_BACKGND_MUSIC_PAUSE);
-            break;
+      case FUNC_BACKGND_MUSIC_PAUSE:
+        newActiveFunctions |= (1 << FUNCTION_BACKGND_MUSIC_PAUSE);
+        break;
 
 #else
-          case FUNC_PLAY_SOUND:
-          case FUNC_PLAY_TRACK:
-          case FUNC_PLAY_BOTH:
-          case FUNC_PLAY_VALUE: {
-            tmr10ms_t tmr10ms = get_tmr10ms();
-            uint8_t repeatParam = CFN_PLAY_REPEAT(cfn);
-            if (!functionsContext.lastFunctionTime[i] ||
-                (CFN_FUNC(cfn) == FUNC_PLAY_BOTH &&
-                 active !=
-                     (bool)(functionsContext.activeSwitches & switch_mask)) ||
-                (repeatParam &&
-                 (signed)(tmr10ms - functionsContext.lastFunctionTime[i]) >=
-                     1000 * repeatParam)) {
-              functionsContext.lastFunctionTime[i] = tmr10ms;
-              uint8_t param = CFN_PARAM(cfn);
-              if (CFN_FUNC(cfn) == FUNC_PLAY_SOUND) {
-                AUDIO_PLAY(AU_SPECIAL_SOUND_FIRST + param);
-              } else if (CFN_FUNC(cfn) == FUNC_PLAY_VALUE) {
-                PLAY_VALUE(param, PLAY_INDEX);
-              } else {
+      case FUNC_PLAY_SOUND:
+      case FUNC_PLAY_TRACK:
+      case FUNC_PLAY_BOTH:
+      case FUNC_PLAY_VALUE: {
+        tmr10ms_t tmr10ms = get_tmr10ms();
+        uint8_t repeatParam = CFN_PLAY_REPEAT(cfn);
+        if (!functionsContext.lastFunctionTime[i] ||
+            (CFN_FUNC(cfn) == FUNC_PLAY_BOTH &&
+             active !=
+                 (bool)(functionsContext.activeSwitches & switch_mask)) ||
+            (repeatParam &&
+             (signed)(tmr10ms - functionsContext.lastFunctionTime[i]) >=
+                 1000 * repeatParam)) {
+          functionsContext.lastFunctionTime[i] = tmr10ms;
+          uint8_t param = CFN_PARAM(cfn);
+          if (CFN_FUNC(cfn) == FUNC_PLAY_SOUND) {
+            AUDIO_PLAY(AU_SPECIAL_SOUND_FIRST + param);
+          } else if (CFN_FUNC(cfn) == FUNC_PLAY_VALUE) {
+            PLAY_VALUE(param, PLAY_INDEX);
+          } else {
 #if defined(GVARS)
-                if (CFN_FUNC(cfn) == FUNC_PLAY_TRACK && param > 250)
-                  param = GVAR_VALUE(
-                      param - 251,
-                      getGVarFlightMode(mixerCurrentFlightMode, param - 251));
+            if (CFN_FUNC(cfn) == FUNC_PLAY_TRACK && param > 250)
+              param = GVAR_VALUE(
+                  param - 251,
+                  getGVarFlightMode(mixerCurrentFlightMode, param - 251));
 #endif
-                PUSH_CUSTOM_PROMPT(active ? param : param + 1, PLAY_INDEX);
-              }
-            }
-            if (!active) {
-              // PLAY_BOTH would change activeFnSwitches otherwise
-              switch_mask = 0;
-            }
-            break;
+            PUSH_CUSTOM_PROMPT(active ? param : param + 1, PLAY_INDEX);
           }
+        }
+        if (!active) {
+          // PLAY_BOTH would change activeFnSwitches otherwise
+          switch_mask = 0;
+        }
+        break;
+      }
 #endif
 
 #if defined(VARIO)
-          case FUNC_VARIO:
-            newActiveFunctions |= (1u << FUNCTION_VARIO);
-            break;
+      case FUNC_VARIO:
+        newActiveFunctions |= (1u << FUNCTION_VARIO);
+        break;
 #endif
 
 #if defined(SDCARD)
-          case FUNC_LOGS:
-            if (CFN_PARAM(cfn)) {
-              newActiveFunctions |= (1u << FUNCTION_LOGS);
-              logDelay100ms = CFN_PARAM(
-                  cfn);  // logging period is 0..25.5s in 100ms increments
-            }
-            break;
+      case FUNC_LOGS:
+        if (CFN_PARAM(cfn)) {
+          newActiveFunctions |= (1u << FUNCTION_LOGS);
+          logDelay100ms = CFN_PARAM(
+              cfn);  // logging period is 0..25.5s in 100ms increments
+        }
+        break;
 #endif
 
-          case FUNC_BACKLIGHT: {
-            newActiveFunctions |= (1u << FUNCTION_BACKLIGHT);
-            if (!CFN_PARAM(cfn)) {  // When no source is set, backlight works
-                                    // like original backlight and turn on
-                                    // regardless of backlight settings
-              requiredBacklightBright = BACKLIGHT_FORCED_ON;
-              break;
-            }
+      case FUNC_BACKLIGHT: {
+        newActiveFunctions |= (1u << FUNCTION_BACKLIGHT);
+        if (!CFN_PARAM(cfn)) {  // When no source is set, backlight works
+                                // like original backlight and turn on
+                                // regardless of backlight settings
+          requiredBacklightBright = BACKLIGHT_FORCED_ON;
+          break;
+        }
 
-            getvalue_t raw = getValue(CFN_PARAM(cfn));
+        getvalue_t raw = getValue(CFN_PARAM(cfn));
 #if defined(COLORLCD)
-            if (raw == -1024)
-              requiredBacklightBright = 100;
-            else
-              requiredBacklightBright =
-                  (1024 - raw) * (BACKLIGHT_LEVEL_MAX - BACKLIGHT_LEVEL_MIN) /
-                  2048;
+        if (raw == -1024)
+          requiredBacklightBright = 100;
+        else
+          requiredBacklightBright =
+              (1024 - raw) * (BACKLIGHT_LEVEL_MAX - BACKLIGHT_LEVEL_MIN) /
+              2048;
 #else
-            requiredBacklightBright = (1024 - raw) * 100 / 2048;
+        requiredBacklightBright = (1024 - raw) * 100 / 2048;
 #endif
-            break;
-          }
+        break;
+      }
 
-          case FUNC_SCREENSHOT:
-            if (!(functionsContext.activeSwitches & switch_mask)) {
-              mainRequestFlags |= (1u << REQUEST_SCREENSHOT);
-            }
-            break;
+      case FUNC_SCREENSHOT:
+        if (!(functionsContext.activeSwitches & switch_mask)) {
+          mainRequestFlags |= (1u << REQUEST_SCREENSHOT);
+        }
+        break;
 
 #if defined(PXX2)
-          case FUNC_RACING_MODE:
-            if (isRacingModeEnabled()) {
-              newActiveFunctions |= (1u << FUNCTION_RACING_MODE);
-            }
-            break;
+      case FUNC_RACING_MODE:
+        if (isRacingModeEnabled()) {
+          newActiveFunctions |= (1u << FUNCTION_RACING_MODE);
+        }
+        break;
 #endif
 #if defined(HARDWARE_TOUCH)
-          case FUNC_DISABLE_TOUCH:
-            newActiveFunctions |= (1u << FUNCTION_DISABLE_TOUCH);
-            break;
+      case FUNC_DISABLE_TOUCH:
+        newActiveFunctions |= (1u << FUNCTION_DISABLE_TOUCH);
+        break;
 #endif
 #if defined(COLORLCD)
-          case FUNC_SET_SCREEN:
-            if (isRepeatDelayElapsed(functions, functionsContext, i)) {
-              TRACE("SET VIEW %d", (CFN_PARAM(cfn)));
-              int8_t screenNumber = max(0, CFN_PARAM(cfn) - 1);
-              setRequestedMainView(screenNumber);
-              mainRequestFlags |= (1u << REQUEST_MAIN_VIEW);
-            }
-            break;
+      case FUNC_SET_SCREEN:
+        if (isRepeatDelayElapsed(functions, functionsContext, i)) {
+          TRACE("SET VIEW %d", (CFN_PARAM(cfn)));
+          int8_t screenNumber = max(0, CFN_PARAM(cfn) - 1);
+          setRequestedMainView(screenNumber);
+          mainRequestFlags |= (1u << REQUEST_MAIN_VIEW);
+        }
+        break;
+
+      case FUNC_SCREEN_RECORD:
+        newActiveFunctions |= (1u << FUNCTION_SCREEN_RECORD);
+        break;
 #endif
 #if defined(DEBUG)
-          case FUNC_TEST:
-            testFunc();
-            break;
+      case FUNC_TEST:
+        testFunc();
+        break;
 #endif
-        }
+    }
 
-        newActiveSwitches |= switch_mask;
-      } else {
-        functionsContext.lastFunctionTime[i] = 0;
+    newActiveSwitches |= switch_mask;
+  } else {
+    functionsContext.lastFunctionTime[i] = 0;
 #if defined(DANGEROUS_MODULE_FUNCTIONS)
-        if (functionsContext.activeSwitches & switch_mask) {
-          switch (CFN_FUNC(cfn)) {
-            case FUNC_RANGECHECK:
-            case FUNC_BIND:
-            {
-              unsigned int moduleIndex = CFN_PARAM(cfn);
-              if (moduleIndex < NUM_MODULES) {
-                moduleState[moduleIndex].mode = 0;
-              }
-              break;
-            }
+    if (functionsContext.activeSwitches & switch_mask) {
+      switch (CFN_FUNC(cfn)) {
+        case FUNC_RANGECHECK:
+        case FUNC_BIND:
+        {
+          unsigned int moduleIndex = CFN_PARAM(cfn);
+          if (moduleIndex < NUM_MODULES) {
+            moduleState[moduleIndex].mode = 0;
           }
+          break;
         }
+      }
+    }
+#endif
+  }
+}
+
+static bool isFunctionSwitchActive(const CustomFunctionData * cfn, bool active)
+{
+  if (HAS_ENABLE_PARAM(CFN_FUNC(cfn))) {
+    active &= (bool)CFN_ACTIVE(cfn);
+  }
+  return active;
+}
+
+void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
+{
+  // all the triggered functions are evaluated once after a change
+  bool evalAll = !functionsContext.compiled;
+  if (evalAll) {
+    compileFunctions(functions, functionsContext);
+  }
+
+  MASK_FUNC_TYPE newActiveFunctions  = 0;
+  // the triggered functions keep their state while their group is not evaluated
+  MASK_CFN_TYPE  newActiveSwitches = functionsContext.activeSwitches & functionsContext.triggerMask;
+
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    safetyCh[i] = OVERRIDE_CHANNEL_UNDEFINED;
+  }
+#endif
+
+#if defined(GVARS)
+  for (uint8_t i=0; i<MAX_TRIMS; i++) {
+    trimGvar[i] = -1;
+  }
 #endif
+
+  for (uint8_t n=0; n<functionsContext.levelCount; n++) {
+    uint8_t i = functionsContext.level[n];
+    const CustomFunctionData * cfn = &functions[i];
+    bool active = getSwitch(CFN_SWITCH(cfn), getFunctionSwitchFlags(cfn));
+    evalFunction(functions, functionsContext, i, isFunctionSwitchActive(cfn, active),
+                 newActiveFunctions, newActiveSwitches);
+  }
+
+  // a group of triggered functions sharing a switch is only evaluated when the
+  // switch changes or when the next repeat of one of its functions is due
+  tmr10ms_t now = get_tmr10ms();
+  for (uint8_t g=0; g<functionsContext.groupCount; g++) {
+    uint8_t first = functionsContext.groupStart[g];
+    uint8_t last = functionsContext.groupStart[g + 1];
+    const CustomFunctionData * cfn = &functions[functionsContext.trigger[first]];
+    MASK_CFN_TYPE group_mask = ((MASK_CFN_TYPE)1 << g);
+
+    bool active = getSwitch(CFN_SWITCH(cfn), getFunctionSwitchFlags(cfn));
+    if (!evalAll && active == (bool)(functionsContext.groupActive & group_mask)) {
+      if (!active || !(functionsContext.groupRepeat & group_mask) ||
+          (signed)(now - functionsContext.groupDeadline[g]) < 0) {
+        continue;
+      }
+    }
+
+    if (active)
+      functionsContext.groupActive |= group_mask;
+    else
+      functionsContext.groupActive &= ~group_mask;
+    functionsContext.groupRepeat &= ~group_mask;
+
+    for (uint8_t n=first; n<last; n++) {
+      uint8_t i = functionsContext.trigger[n];
+      cfn = &functions[i];
+      newActiveSwitches &= ~((MASK_CFN_TYPE)1 << i);
+
+      bool fnActive = isFunctionSwitchActive(cfn, active);
+      evalFunction(functions, functionsContext, i, fnActive, newActiveFunctions, newActiveSwitches);
+
+      tmr10ms_t deadline;
+      if (fnActive && getRepeatDeadline(cfn, functionsContext.lastFunctionTime[i], deadline)) {
+        if (!(functionsContext.groupRepeat & group_mask) ||
+            (signed)(deadline - functionsContext.groupDeadline[g]) < 0) {
+          functionsContext.groupDeadline[g] = deadline;
+        }
+        functionsContext.groupRepeat |= group_mask;
       }
     }
   }
@@ -530,6 +686,8 @@ const char* funcGetLabel(uint8_t func)
     return STR_SF_DISABLE_TOUCH;
   case FUNC_SET_SCREEN:
     return STR_SF_SET_SCREEN;
+  case FUNC_SCREEN_RECORD:
+    return STR_SF_SCREEN_RECORD;
 #endif
 #if defined(DEBUG)
   case FUNC_TEST:
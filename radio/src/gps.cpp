@@ -308,8 +308,174 @@ bool gpsNewFrameNMEA(char c)
   return frameOK;
 }
 
+/* UBX binary protocol (u-blox receivers)
+
+   NAV-PVT carries everything needed in one frame, so the receiver is switched
+   to it (and NAV-DOP for HDOP) when it answers to UBX commands. The payload
+   is decoded in place from the receive buffer, in the same units as the NMEA
+   decoder above. Receivers not answering keep being decoded as NMEA.
+*/
+
+#define UBX_SYNC1                0xB5
+#define UBX_SYNC2                0x62
+#define UBX_CLASS_NAV            0x01
+#define UBX_CLASS_CFG            0x06
+#define UBX_CLASS_NMEA           0xF0
+#define UBX_NAV_DOP              0x04
+#define UBX_NAV_PVT              0x07
+#define UBX_CFG_PRT              0x00
+#define UBX_CFG_MSG              0x01
+#define UBX_CFG_RATE             0x08
+#define UBX_NAV_DOP_LENGTH       18
+#define UBX_NAV_PVT_LENGTH       92
+#define UBX_MAX_PAYLOAD          UBX_NAV_PVT_LENGTH
+#define UBX_MAX_LENGTH           512
+
+enum UbxParserState {
+  UBX_STATE_SYNC1,
+  UBX_STATE_SYNC2,
+  UBX_STATE_CLASS,
+  UBX_STATE_ID,
+  UBX_STATE_LENGTH1,
+  UBX_STATE_LENGTH2,
+  UBX_STATE_PAYLOAD,
+  UBX_STATE_CK_A,
+  UBX_STATE_CK_B,
+};
+
+static struct {
+  uint8_t state;
+  uint8_t msgClass;
+  uint8_t msgId;
+  uint16_t length;
+  uint16_t offset;
+  uint8_t ckA;
+  uint8_t ckB;
+  uint8_t payload[UBX_MAX_PAYLOAD];
+} ubx;
+
+// set each time a valid UBX frame is received
+static bool ubxReceived = false;
+
+static inline uint16_t ubxU2(const uint8_t * p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static inline int32_t ubxI4(const uint8_t * p)
+{
+  return (int32_t)(p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+static bool gpsDecodeUBX()
+{
+  const uint8_t * p = ubx.payload;
+
+  if (ubx.msgClass != UBX_CLASS_NAV)
+    return false;
+
+  if (ubx.msgId == UBX_NAV_PVT && ubx.length == UBX_NAV_PVT_LENGTH) {
+    uint8_t fixType = p[20];
+    bool fix = (p[21] & 0x01) && fixType >= 2 && fixType <= 4; // gnssFixOK and 2D / 3D / GNSS+DR
+    gpsData.fix = fix;
+    gpsData.numSat = p[23];
+    if (fix) {
+      __disable_irq();    // do the atomic update of lat/lon
+      gpsData.latitude = ubxI4(p + 28) / 10;           // 1e-7 deg
+      gpsData.longitude = ubxI4(p + 24) / 10;          // 1e-7 deg
+      gpsData.altitude = ubxI4(p + 36) / 1000;         // mm
+      __enable_irq();
+    }
+    gpsData.speed = ubxI4(p + 60) / 10;                // mm/s
+    gpsData.groundCourse = ubxI4(p + 64) / 10000;      // 1e-5 deg
+#if defined(RTCLOCK)
+    // set RTC clock if needed (validDate and validTime)
+    if (g_eeGeneral.adjustRTC && fix && (p[11] & 0x03) == 0x03) {
+      rtcAdjust(ubxU2(p + 4), p[6], p[7], p[8], p[9], p[10]);
+    }
+#endif
+    return true;
+  }
+
+  if (ubx.msgId == UBX_NAV_DOP && ubx.length == UBX_NAV_DOP_LENGTH) {
+    gpsData.hdop = ubxU2(p + 12);                      // 0.01
+  }
+
+  return false;
+}
+
+bool gpsNewFrameUBX(uint8_t c)
+{
+  switch (ubx.state) {
+    case UBX_STATE_SYNC1:
+      if (c == UBX_SYNC1)
+        ubx.state = UBX_STATE_SYNC2;
+      return false;
+    case UBX_STATE_SYNC2:
+      if (c == UBX_SYNC1)
+        return false; // may be the real start of frame
+      ubx.state = (c == UBX_SYNC2 ? UBX_STATE_CLASS : UBX_STATE_SYNC1);
+      ubx.ckA = ubx.ckB = 0;
+      return false;
+  }
+
+  if (ubx.state < UBX_STATE_CK_A) {
+    ubx.ckA += c;
+    ubx.ckB += ubx.ckA;
+  }
+
+  switch (ubx.state) {
+    case UBX_STATE_CLASS:
+      ubx.msgClass = c;
+      ubx.state = UBX_STATE_ID;
+      break;
+    case UBX_STATE_ID:
+      ubx.msgId = c;
+      ubx.state = UBX_STATE_LENGTH1;
+      break;
+    case UBX_STATE_LENGTH1:
+      ubx.length = c;
+      ubx.state = UBX_STATE_LENGTH2;
+      break;
+    case UBX_STATE_LENGTH2:
+      ubx.length |= c << 8;
+      ubx.offset = 0;
+      if (ubx.length > UBX_MAX_LENGTH)
+        ubx.state = UBX_STATE_SYNC1; // corrupted, don't swallow the next frames
+      else
+        ubx.state = (ubx.length > 0 ? UBX_STATE_PAYLOAD : UBX_STATE_CK_A);
+      break;
+    case UBX_STATE_PAYLOAD:
+      // longer frames are checked, but not decoded
+      if (ubx.offset < UBX_MAX_PAYLOAD)
+        ubx.payload[ubx.offset] = c;
+      if (++ubx.offset == ubx.length)
+        ubx.state = UBX_STATE_CK_A;
+      break;
+    case UBX_STATE_CK_A:
+      ubx.state = (c == ubx.ckA ? UBX_STATE_CK_B : UBX_STATE_SYNC1);
+      if (ubx.state == UBX_STATE_SYNC1)
+        gpsData.errorCount++;
+      break;
+    case UBX_STATE_CK_B:
+      ubx.state = UBX_STATE_SYNC1;
+      if (c == ubx.ckB) {
+        gpsData.packetCount++;
+        ubxReceived = true;
+        return gpsDecodeUBX();
+      }
+      gpsData.errorCount++;
+      break;
+  }
+
+  return false;
+}
+
 bool gpsNewFrame(uint8_t c)
 {
+  // NMEA frames are plain text, and never contain the UBX sync char
+  if (ubx.state != UBX_STATE_SYNC1 || c == UBX_SYNC1)
+    return gpsNewFrameUBX(c);
   return gpsNewFrameNMEA(c);
 }
 
@@ -327,10 +493,166 @@ static void* gpsSerialCtx = nullptr;
 uint8_t gpsTraceEnabled = false;
 #endif
 
+#define GPS_UBX_BAUDRATE         115200
+#define GPS_UBX_MEAS_RATE        100  // ms (10Hz), once at GPS_UBX_BAUDRATE
+#define GPS_CONFIG_PERIOD        100  // 1s
+#define GPS_CONFIG_RETRIES       5
+#define GPS_FRAME_TIMEOUT        300  // 3s
+#define GPS_DETECT_SWITCHES      4    // baudrate changes without any frame
+
+enum GpsConfigState {
+  GPS_CONFIG_DETECT,
+  GPS_CONFIG_BAUDRATE,
+  GPS_CONFIG_DONE,
+};
+
+static struct {
+  uint8_t state;
+  uint8_t retries;
+  uint8_t switches;
+  uint32_t baudrate;
+  tmr10ms_t lastFrame;
+  tmr10ms_t lastConfig;
+} gpsConfig;
+
+static void gpsResetConfig(uint32_t baudrate)
+{
+  gpsConfig.state = GPS_CONFIG_DETECT;
+  gpsConfig.retries = 0;
+  gpsConfig.baudrate = baudrate;
+  gpsConfig.lastFrame = gpsConfig.lastConfig = get_tmr10ms();
+  ubxReceived = false;
+}
+
 void gpsSetSerialDriver(void* ctx, const etx_serial_driver_t* drv)
 {
   gpsSerialCtx = ctx;
   gpsSerialDrv = drv;
+  gpsConfig.switches = 0;
+  gpsResetConfig(GPS_USART_BAUDRATE);
+}
+
+static void gpsSendUBX(uint8_t msgClass, uint8_t msgId, const uint8_t * payload, uint16_t length)
+{
+  if (!gpsSerialDrv) return;
+
+  auto _sendByte = gpsSerialDrv->sendByte;
+  if (!_sendByte) return;
+
+  const uint8_t header[] = { msgClass, msgId, (uint8_t)length, (uint8_t)(length >> 8) };
+  uint8_t ckA = 0, ckB = 0;
+
+  _sendByte(gpsSerialCtx, UBX_SYNC1);
+  _sendByte(gpsSerialCtx, UBX_SYNC2);
+  for (uint8_t i = 0; i < sizeof(header); i++) {
+    ckA += header[i];
+    ckB += ckA;
+    _sendByte(gpsSerialCtx, header[i]);
+  }
+  for (uint16_t i = 0; i < length; i++) {
+    ckA += payload[i];
+    ckB += ckA;
+    _sendByte(gpsSerialCtx, payload[i]);
+  }
+  _sendByte(gpsSerialCtx, ckA);
+  _sendByte(gpsSerialCtx, ckB);
+}
+
+static void gpsSetMessageRate(uint8_t msgClass, uint8_t msgId, uint8_t rate)
+{
+  const uint8_t payload[] = { msgClass, msgId, rate };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_MSG, payload, sizeof(payload));
+}
+
+static void gpsSetPortBaudrate(uint32_t baudrate)
+{
+  const uint8_t payload[] = {
+    0x01, 0x00, 0x00, 0x00,                         // UART1
+    0xD0, 0x08, 0x00, 0x00,                         // 8N1
+    (uint8_t)baudrate, (uint8_t)(baudrate >> 8),
+    (uint8_t)(baudrate >> 16), (uint8_t)(baudrate >> 24),
+    0x03, 0x00,                                     // in: UBX + NMEA
+    0x03, 0x00,                                     // out: UBX + NMEA
+    0x00, 0x00, 0x00, 0x00,
+  };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_PRT, payload, sizeof(payload));
+}
+
+static void gpsSetMeasurementRate(uint16_t rate)
+{
+  const uint8_t payload[] = {
+    (uint8_t)rate, (uint8_t)(rate >> 8),
+    0x01, 0x00,                                     // 1 measurement per solution
+    0x01, 0x00,                                     // GPS time
+  };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_RATE, payload, sizeof(payload));
+}
+
+// Switches u-blox receivers to NAV-PVT, at a higher baudrate and update rate
+// when the serial driver can follow. The receiver may have kept its
+// configuration (backup supply), hence both baudrates are tried. With no
+// receiver answering, the port is left at the default baudrate after
+// GPS_DETECT_SWITCHES changes, until frames are received again.
+static void gpsConfigure()
+{
+  tmr10ms_t now = get_tmr10ms();
+
+  if ((tmr10ms_t)(now - gpsConfig.lastFrame) > GPS_FRAME_TIMEOUT) {
+    uint32_t baudrate = gpsConfig.baudrate;
+    if (gpsConfig.switches >= GPS_DETECT_SWITCHES) {
+      if (baudrate == GPS_USART_BAUDRATE)
+        return;
+      baudrate = GPS_USART_BAUDRATE;
+    }
+    else {
+      gpsConfig.switches++;
+      baudrate = (baudrate == GPS_USART_BAUDRATE ? GPS_UBX_BAUDRATE : GPS_USART_BAUDRATE);
+    }
+    if (gpsSerialDrv->setBaudrate) {
+      gpsSerialDrv->setBaudrate(gpsSerialCtx, baudrate);
+    }
+    else {
+      baudrate = gpsConfig.baudrate;
+    }
+    gpsResetConfig(baudrate);
+    return;
+  }
+
+  if ((tmr10ms_t)(now - gpsConfig.lastConfig) < GPS_CONFIG_PERIOD)
+    return;
+  gpsConfig.lastConfig = now;
+
+  switch (gpsConfig.state) {
+    case GPS_CONFIG_DETECT:
+      if (!ubxReceived) {
+        // NMEA only receivers ignore it
+        if (gpsConfig.retries < GPS_CONFIG_RETRIES) {
+          gpsConfig.retries++;
+          gpsSetMessageRate(UBX_CLASS_NAV, UBX_NAV_PVT, 1);
+          gpsSetMessageRate(UBX_CLASS_NAV, UBX_NAV_DOP, 5);
+        }
+      }
+      else if (gpsSerialDrv->setBaudrate && gpsConfig.baudrate != GPS_UBX_BAUDRATE) {
+        gpsSetPortBaudrate(GPS_UBX_BAUDRATE);
+        gpsConfig.state = GPS_CONFIG_BAUDRATE;
+      }
+      else {
+        if (gpsConfig.baudrate == GPS_UBX_BAUDRATE)
+          gpsSetMeasurementRate(GPS_UBX_MEAS_RATE);
+        // NAV-PVT replaces GGA, GLL, GSA, GSV, RMC and VTG
+        for (uint8_t msgId = 0x00; msgId <= 0x05; msgId++)
+          gpsSetMessageRate(UBX_CLASS_NMEA, msgId, 0);
+        gpsConfig.state = GPS_CONFIG_DONE;
+        TRACE("GPS: UBX @ %d", gpsConfig.baudrate);
+      }
+      break;
+
+    case GPS_CONFIG_BAUDRATE:
+      // the port configuration has been sent at the previous baudrate
+      gpsSerialDrv->setBaudrate(gpsSerialCtx, GPS_UBX_BAUDRATE);
+      gpsResetConfig(GPS_UBX_BAUDRATE);
+      break;
+  }
 }
 
 void gpsWakeup()
@@ -340,6 +662,8 @@ void gpsWakeup()
   auto _getByte = gpsSerialDrv->getByte;
   if (!_getByte) return;
 
+  uint32_t packetCount = gpsData.packetCount;
+
   uint8_t byte;
   while (_getByte(gpsSerialCtx, &byte)) {
 #if defined(DEBUG)
@@ -349,6 +673,13 @@ void gpsWakeup()
 #endif  
     gpsNewData(byte);
   }
+
+  if (gpsData.packetCount != packetCount) {
+    gpsConfig.lastFrame = get_tmr10ms();
+    gpsConfig.switches = 0;
+  }
+
+  gpsConfigure();
 }
 
 char hex(uint8_t b) {
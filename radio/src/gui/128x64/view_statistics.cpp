@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "tasks.h"
+#include "tasks/mixer_task.h"
 #include "mixer_scheduler.h"
 
 #include "hal/adc_driver.h"
@@ -137,6 +138,7 @@ void menuStatisticsDebug(event_t event)
       maxLuaDuration = 0;
 #endif
       maxMixerDuration  = 0;
+      mixerTimingStats.reset();
       break;
 
     case EVT_KEY_FIRST(KEY_UP):
@@ -218,6 +220,15 @@ void menuStatisticsDebug(event_t event)
   lcdDrawNumber(lcdLastRightPos, y, audioStack.available(), LEFT);
   y += FH;
 
+  lcdDrawTextAlignedLeft(y, STR_CPU_LOAD);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, getTaskCpuLoad(TASK_MENUS) / 10, LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, getTaskCpuLoad(TASK_MIXER) / 10, LEFT);
+  lcdDrawText(lcdLastRightPos, y, "/");
+  lcdDrawNumber(lcdLastRightPos, y, getTaskCpuLoad(TASK_AUDIO) / 10, LEFT);
+  lcdDrawText(lcdLastRightPos, y, "%");
+  y += FH;
+
 #if defined(DEBUG_LATENCY)
   lcdDrawTextAlignedLeft(y, STR_HEARTBEAT_LABEL);
   if (heartbeatCapture.valid)
@@ -270,6 +281,10 @@ void menuStatisticsDebug2(event_t event)
   // lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, telemetryErrors, RIGHT);
   y += FH;
 
+  lcdDrawTextAlignedLeft(y, STR_MIXER_LATE);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, mixerTimingStats.deadlineMisses(), LEFT);
+  y += FH;
+
 #if defined(BLUETOOTH)
   lcdDrawTextAlignedLeft(y, "BT status");
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, IS_BLUETOOTH_CHIP_PRESENT(), RIGHT);
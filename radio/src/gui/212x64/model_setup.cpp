@@ -1724,6 +1724,10 @@ void menuModelSetup(event_t event)
          auto & module = g_model.moduleData[moduleIdx];
          module.ghost.raw12bits = editCheckBox(module.ghost.raw12bits , MODEL_SETUP_2ND_COLUMN, y, INDENT "Raw 12 bits", attr, event);
        }
+       else if (isModuleCrossfire(moduleIdx)) {
+         auto & module = g_model.moduleData[moduleIdx];
+         module.crsf.subsetChannels = editCheckBox(module.crsf.subsetChannels, MODEL_SETUP_2ND_COLUMN, y, INDENT "Subset chans", attr, event);
+       }
      }
      break;
 
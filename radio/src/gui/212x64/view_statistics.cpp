@@ -22,6 +22,7 @@
 #include "hal/adc_driver.h"
 #include "opentx.h"
 #include "tasks.h"
+#include "tasks/mixer_task.h"
 
 #define STATS_1ST_COLUMN               FW/2
 #define STATS_2ND_COLUMN               12*FW+FW/2
@@ -132,6 +133,7 @@ void menuStatisticsDebug(event_t event)
       maxLuaDuration = 0;
 #endif
       maxMixerDuration  = 0;
+      mixerTimingStats.reset();
       break;
 
     case EVT_KEY_FIRST(KEY_PLUS):
@@ -184,6 +186,8 @@ void menuStatisticsDebug(event_t event)
   lcdDrawTextAlignedLeft(y, STR_TMIXMAXMS);
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, DURATION_MS_PREC2(maxMixerDuration), PREC2|LEFT);
   lcdDrawText(lcdLastRightPos, y, STR_MS);
+  lcdDrawText(lcdLastRightPos+FW, y, STR_MIXER_LATE);
+  lcdDrawNumber(lcdLastRightPos+FW, y, mixerTimingStats.deadlineMisses(), LEFT);
   y += FH;
 
   lcdDrawTextAlignedLeft(y, STR_FREE_STACK);
@@ -197,6 +201,16 @@ void menuStatisticsDebug(event_t event)
   lcdDrawNumber(lcdLastRightPos, y, mainStackAvailable(), LEFT);
   y += FH;
 
+  lcdDrawTextAlignedLeft(y, STR_CPU_LOAD);
+  lcdDrawText(MENU_DEBUG_COL1_OFS, y+1, "[M]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, getTaskCpuLoad(TASK_MENUS), PREC1|LEFT);
+  lcdDrawText(lcdLastRightPos+2, y+1, "[X]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, getTaskCpuLoad(TASK_MIXER), PREC1|LEFT);
+  lcdDrawText(lcdLastRightPos+2, y+1, "[A]", SMLSIZE);
+  lcdDrawNumber(lcdLastRightPos, y, getTaskCpuLoad(TASK_AUDIO), PREC1|LEFT);
+  lcdDrawText(lcdLastRightPos, y, "%");
+  y += FH;
+
 #if defined(DEBUG_LATENCY)
   lcdDrawTextAlignedLeft(y, STR_HEARTBEAT_LABEL);
   if (heartbeatCapture.valid)
@@ -292,10 +306,10 @@ void menuTraceBuffer(event_t event)
 
     const struct TraceElement * te = getTraceElement(k);
     if (te) {
-      //time
-      int32_t tme = te->time % SECS_PER_DAY;
-      drawTimer(4*FW, y, tme, TIMEHOUR|LEFT, TIMEHOUR|LEFT);
+      //time (us, wraps around with the CPU cycles counter)
+      lcdDrawNumber(4*FW, y, te->time / getTraceTicksPerUs(), LEFT);
       //event
+      lcdDrawChar(13*FW, y, te->type);
       lcdDrawNumber(14*FW, y, te->event, LEADING0|LEFT, 3);
       //data
       lcdDrawSizedText  (20*FW, y, "0x", 2);
@@ -370,7 +370,9 @@ void LvglWrapper::run()
   lv_tick_inc((tick - lastTick) * 10);
   lastTick = tick;
 #endif
+  TRACE_EVENT_BEGIN(trace_lvgl);
   lv_timer_handler();
+  TRACE_EVENT_END(trace_lvgl);
 }
 
 void LvglWrapper::runNested()
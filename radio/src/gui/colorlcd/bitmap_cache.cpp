@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bitmap_cache.h"
+#include "debug.h"
+#include "ff.h"
+
+static BitmapCache bitmapCache;
+
+BitmapCache * BitmapCache::instance()
+{
+  return &bitmapCache;
+}
+
+extern "C" void bitmapCacheFilesChanged()
+{
+  bitmapCache.filesChanged();
+}
+
+static bool getFileInfo(const char * path, uint32_t & size, uint32_t & time)
+{
+  FILINFO info;
+  if (f_stat(path, &info) != FR_OK) return false;
+  size = info.fsize;
+  time = (uint32_t)info.fdate << 16 | info.ftime;
+  return true;
+}
+
+static std::string makeKey(const char * path, coord_t w, coord_t h)
+{
+  std::string key(path);
+  if (w > 0 && h > 0) {
+    key += '@';
+    key += std::to_string(w);
+    key += 'x';
+    key += std::to_string(h);
+  }
+  return key;
+}
+
+SharedBitmap BitmapCache::get(const char * path, coord_t w, coord_t h)
+{
+  if (!path || !path[0]) return nullptr;
+
+  std::string key = makeKey(path, w, h);
+
+  auto found = index.find(key);
+  if (found != index.end()) {
+    auto it = found->second;
+    if (it->generation != generation) {
+      // files have been written since the last check
+      uint32_t size, time;
+      if (getFileInfo(path, size, time) && size == it->fileSize &&
+          time == it->fileTime) {
+        it->generation = generation;
+      } else {
+        remove(it);
+        it = entries.end();
+      }
+    }
+    if (it != entries.end()) {
+      hits += 1;
+      entries.splice(entries.begin(), entries, it);
+      return it->bitmap;
+    }
+  }
+
+  uint32_t fileSize = 0, fileTime = 0;
+  if (!getFileInfo(path, fileSize, fileTime)) return nullptr;
+
+  misses += 1;
+  BitmapBuffer * bitmap = decode(path, w, h);
+  if (!bitmap && !entries.empty()) {
+    // probably low on memory: drop what is not used and try again
+    trim(0);
+    bitmap = decode(path, w, h);
+  }
+  if (!bitmap) return nullptr;
+
+  uint32_t size = bitmap->getDataSize();
+  trim(budget > size ? budget - size : 0);
+
+  // the memory is released from the cache usage with the last reference
+  SharedBitmap shared(bitmap, [this, size](const BitmapBuffer * b) {
+    usage = usage > size ? usage - size : 0;
+    delete b;
+  });
+  usage += size;
+
+  entries.push_front({key, path, shared, fileSize, fileTime, generation});
+  index[key] = entries.begin();
+
+  return shared;
+}
+
+BitmapBuffer * BitmapCache::decode(const char * path, coord_t w, coord_t h)
+{
+  BitmapBuffer * bitmap = BitmapBuffer::loadBitmap(path);
+  if (!bitmap || w <= 0 || h <= 0) return bitmap;
+  if (bitmap->width() == w && bitmap->height() == h) return bitmap;
+
+  BitmapBuffer * scaled = new BitmapBuffer(bitmap->getFormat(), w, h);
+  if (scaled) {
+    scaled->clear();
+    scaled->drawScaledBitmap(bitmap, 0, 0, w, h);
+  }
+  delete bitmap;
+  return scaled;
+}
+
+void BitmapCache::remove(std::list<Entry>::iterator it)
+{
+  index.erase(it->key);
+  entries.erase(it);
+}
+
+void BitmapCache::trim(uint32_t maxUsage)
+{
+  for (auto it = entries.end(); usage > maxUsage && it != entries.begin();) {
+    auto prev = std::prev(it);
+    if (prev->bitmap.use_count() == 1) {
+      // not used elsewhere: erasing the entry frees the bitmap
+      remove(prev);
+    } else {
+      it = prev;
+    }
+  }
+}
+
+void BitmapCache::invalidate(const char * path)
+{
+  for (auto it = entries.begin(); it != entries.end();) {
+    auto next = std::next(it);
+    if (it->path == path) remove(it);
+    it = next;
+  }
+}
+
+void BitmapCache::clear()
+{
+  TRACE("BitmapCache::clear() %u bytes, %u hits, %u misses", usage, hits,
+        misses);
+  // bitmaps still in use are released with their last reference
+  index.clear();
+  entries.clear();
+}
+
+bool BitmapCache::isFull()
+{
+  trim(budget);
+  return usage > budget;
+}
+
+void BitmapCache::setBudget(uint32_t bytes)
+{
+  budget = bytes;
+  trim(budget);
+}
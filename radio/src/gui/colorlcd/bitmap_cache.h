@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "bitmapbuffer.h"
+
+#if !defined(BITMAP_CACHE_BUDGET)
+  #define BITMAP_CACHE_BUDGET  (2 * 1024 * 1024)
+#endif
+
+typedef std::shared_ptr<const BitmapBuffer> SharedBitmap;
+
+// Cache of decoded SD card images.
+//
+// Entries are keyed by path and requested size. Files are not checked again
+// on each lookup: invalidate() or clear() must be called when images may
+// have changed on the SD card (USB mass storage, SD manager). Writers which
+// may touch any file (Lua io) call filesChanged() instead: each entry is then
+// checked once against the size and date of its file on its next lookup.
+// Files changed by other means are served stale until then.
+//
+// Bitmaps are reference counted, and the cache usage accounts for every
+// bitmap it decoded until the last reference is released, whether it is
+// still cached or not. Only entries which are not used elsewhere are
+// evicted to stay within the budget.
+//
+// Must only be used from the UI task.
+class BitmapCache
+{
+  public:
+    static BitmapCache * instance();
+
+    // Returns the decoded bitmap (or nullptr if it cannot be loaded).
+    // When 'w' and 'h' are given, a pre-scaled variant is returned instead
+    // of the native image; only the scaled variant is kept in memory.
+    SharedBitmap get(const char * path, coord_t w = 0, coord_t h = 0);
+
+    void invalidate(const char * path);
+    void clear();
+    void filesChanged() { generation += 1; }
+
+    // true if the budget is exceeded by bitmaps which are still in use
+    bool isFull();
+
+    void setBudget(uint32_t bytes);
+    uint32_t getBudget() const { return budget; }
+    uint32_t getUsage() const { return usage; }
+    uint32_t getHits() const { return hits; }
+    uint32_t getMisses() const { return misses; }
+
+  protected:
+    struct Entry {
+      std::string key;
+      std::string path;
+      SharedBitmap bitmap;
+      uint32_t fileSize;
+      uint32_t fileTime;
+      uint32_t generation;
+    };
+
+    std::list<Entry> entries;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    uint32_t budget = BITMAP_CACHE_BUDGET;
+    uint32_t usage = 0;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t generation = 0;
+
+    void remove(std::list<Entry>::iterator it);
+    void trim(uint32_t maxUsage);
+    BitmapBuffer * decode(const char * path, coord_t w, coord_t h);
+};
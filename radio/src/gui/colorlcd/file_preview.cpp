@@ -20,6 +20,7 @@
  */
 
 #include "file_preview.h"
+#include "bitmap_cache.h"
 #include "sdcard.h"
 
 FilePreview::FilePreview(Window *parent, const rect_t &rect,
@@ -28,22 +29,14 @@ FilePreview::FilePreview(Window *parent, const rect_t &rect,
 {
 }
 
-FilePreview::~FilePreview()
-{
-  if (bitmap != nullptr) delete bitmap;
-}
-
 void FilePreview::setFile(const char *filename)
 {
-  if (bitmap != nullptr) delete bitmap;
   bitmap = nullptr;
 
   if (filename) {
     const char *ext = getFileExtension(filename);
     if (ext && isExtensionMatching(ext, BITMAPS_EXT)) {
-      bitmap = BitmapBuffer::loadBitmap(filename);
-    } else {
-      bitmap = nullptr;
+      bitmap = BitmapCache::instance()->get(filename);
     }
   }
   invalidate();
@@ -76,5 +69,5 @@ void FilePreview::paint(BitmapBuffer *dc)
   coord_t y = border_w + lv_obj_get_style_pad_top(lvobj, 0);
 
   dc->setFormat(BMP_RGB565);
-  dc->drawScaledBitmap(bitmap, x + (w - bm_w) / 2, y + (h - bm_h) / 2, bm_w, bm_h);
+  dc->drawScaledBitmap(bitmap.get(), x + (w - bm_w) / 2, y + (h - bm_h) / 2, bm_w, bm_h);
 }
@@ -21,12 +21,12 @@
 
 #pragma once
 #include "libopenui.h"
+#include "bitmap_cache.h"
 
 class FilePreview : public Window
 {
  public:
   FilePreview(Window *parent, const rect_t &rect, bool drawCentered = true);
-  ~FilePreview();
 
 #if defined(DEBUG_WINDOWS)
   std::string getName() const override { return "FilePreview"; }
@@ -39,6 +39,6 @@ class FilePreview : public Window
   void paint(BitmapBuffer *dc) override;
 
  protected:
-  BitmapBuffer *bitmap = nullptr;
+  SharedBitmap bitmap;
   bool _drawCentered = true;
 };
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <vector>
 
+#include "bitmap_cache.h"
 #include "libopenui.h"
 #include "listbox.h"
 #include "model_templates.h"
@@ -276,10 +277,9 @@ class ModelButton : public Button
                        COLOR_THEME_SECONDARY1 | CENTERED);
     } else {
       GET_FILENAME(filename, BITMAPS_PATH, modelCell->modelBitmap, "");
-      const BitmapBuffer *bitmap = BitmapBuffer::loadBitmap(filename);
+      auto bitmap = BitmapCache::instance()->get(filename, width(), height());
       if (bitmap) {
-        buffer->drawScaledBitmap(bitmap, 0, 0, width(), height());
-        delete bitmap;
+        buffer->drawBitmap(0, 0, bitmap.get());
       } else {
         std::string errorMsg = "(";
         errorMsg += STR_NO_PICTURE;
@@ -398,6 +398,7 @@ void ModelsPageBody::selectModel(ModelCell *model)
     // store changes (if any) and load selected model
     storageFlushCurrentModel();
     storageCheck(true);
+    modelslist.writeModelLabels(model);
     memcpy(g_eeGeneral.currModelFilename, model->modelFilename,
            LEN_MODEL_FILENAME);
 
@@ -416,6 +417,7 @@ void ModelsPageBody::duplicateModel(ModelCell *model)
       std::string(model->modelName, sizeof(model->modelName)).c_str(), [=] {
         storageFlushCurrentModel();
         storageCheck(true);
+        modelslist.writeModelLabels(model);
 
         char duplicatedFilename[LEN_MODEL_FILENAME + 1];
         memcpy(duplicatedFilename, model->modelFilename,
@@ -427,6 +429,10 @@ void ModelsPageBody::duplicateModel(ModelCell *model)
           // Make a new model which is a copy of the selected one, set the same
           // labels
           auto new_model = modelslist.addModel(duplicatedFilename, true, model);
+          if (!new_model) {
+            POPUP_WARNING(STR_MEMORYWARNING);
+            return;
+          }
           for (const auto &lbl : modelslabels.getLabelsByModel(model)) {
             modelslabels.addLabelToModel(lbl, new_model);
           }
@@ -527,13 +533,6 @@ void ModelsPageBody::update()
 {
   clear();
 
-  ModelsVector models;
-  if (selectedLabels.size()) {
-    models = modelslabels.getModelsInLabels(selectedLabels);
-  } else {
-    models = modelslabels.getAllModels();
-  }
-
   // Used to work out which button to set focus to.
   // Priority -
   //     current active model
@@ -542,7 +541,8 @@ void ModelsPageBody::update()
   ModelButton* firstButton = nullptr;
   ModelButton* focusedButton = nullptr;
 
-  for (auto &model : models) {
+  // all the models if no label is selected
+  modelslabels.forEachModelInLabels(selectedLabels, [&](ModelCell *model) {
     auto button = new ModelButton(this, rect_t{}, model, [=]() {
       focusedModel = model;
     });
@@ -574,7 +574,7 @@ void ModelsPageBody::update()
       openMenu();
       return 0;
     });
-  }
+  });
 
   if (!focusedButton)
     focusedButton = firstButton;
@@ -711,6 +711,10 @@ void ModelLabelsWindow::newModel()
     // Create a new blank ModelCell and activate it first, createmodel() will modify
     // the model in memory.
     auto newCell = modelslist.addModel("", false);
+    if (!newCell) {
+      POPUP_WARNING(STR_MEMORYWARNING);
+      return;
+    }
     modelslist.setCurrentModel(newCell);
 
     // Make the new model
@@ -858,7 +862,7 @@ void ModelLabelsWindow::buildBody(FormWindow *window)
 
   lblselector->setMultiSelectHandler([=](std::set<uint32_t> selected,
                                          std::set<uint32_t> oldselection) {
-    if (modelslabels.getUnlabeledModels().size() != 0) {
+    if (modelslabels.hasUnlabeledModels()) {
       // Special case for mutually exclusive Unsorted
       bool unsrt_is_selected =
           selected.find(lblselector->getRowCount() - 1) != selected.end();
@@ -88,7 +88,7 @@ class ModelLabelsWindow : public Page
   LabelsVector getLabels()
   {
     auto labels = modelslabels.getLabels();
-    if (modelslabels.getUnlabeledModels().size() > 0)
+    if (modelslabels.hasUnlabeledModels())
       labels.emplace_back(STR_UNLABELEDMODEL);
     return labels;
   }
@@ -486,6 +486,17 @@ void ModuleWindow::updateModule()
     new CheckBox(line, rect_t{}, GET_SET_DEFAULT(md->ghost.raw12bits));
   }
 
+  if (isModuleCrossfire(moduleIdx)) {
+    auto line = newLine(&grid);
+    new StaticText(line, rect_t{}, "Subset channels", 0, COLOR_THEME_PRIMARY1);
+    new CheckBox(line, rect_t{}, GET_DEFAULT(md->crsf.subsetChannels),
+                 [=](int32_t newValue) {
+                   md->crsf.subsetChannels = newValue;
+                   if (chRange) chRange->update();
+                   SET_DIRTY();
+                 });
+  }
+
   updateSubType();
 }
 
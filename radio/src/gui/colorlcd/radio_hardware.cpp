@@ -126,6 +126,11 @@ void RadioHardwarePage::build(FormWindow * window)
   new StaticText(line, rect_t{}, STR_JITTER_FILTER, 0, COLOR_THEME_PRIMARY1);
   new CheckBox(line, rect_t{}, GET_SET_INVERTED(g_eeGeneral.noJitterFilter));
 
+  // Skip the periodic updates after a late mixer cycle
+  line = window->newLine(&grid);
+  new StaticText(line, rect_t{}, STR_MIXER_DEFER, 0, COLOR_THEME_PRIMARY1);
+  new CheckBox(line, rect_t{}, GET_SET_DEFAULT(g_eeGeneral.mixerDeferOnOverrun));
+
 #if defined(AUDIO_MUTE_GPIO)
   // Mute audio
   line = window->newLine(&grid);
@@ -31,6 +31,9 @@
 #include "view_text.h"
 #include "file_preview.h"
 #include "file_browser.h"
+#include "model_select.h"
+#include "bitmap_cache.h"
+#include "native_bitmap.h"
 
 constexpr int WARN_FILE_LENGTH = 40 * 1024;
 
@@ -95,10 +98,20 @@ class FileNameEditWindow : public Page
       }
       changedName[totalSize + extLength] = '\0';
       f_rename((const TCHAR *)name.c_str(), (const TCHAR *)changedName);
+      removeNativeSidecar(name.c_str());
+      BitmapCache::instance()->clear();
     });
   };
 };
 
+// the pre-decoded copy of an image is not valid anymore
+static void removeNativeSidecar(const char * path)
+{
+  char sidecar[FF_MAX_LFN + 1];
+  snprintf(sidecar, sizeof(sidecar), "%s" NATIVE_BITMAP_EXT, path);
+  f_unlink(sidecar);
+}
+
 RadioSdManagerPage::RadioSdManagerPage() :
   PageTab(SD_IS_HC() ? STR_SDHC_CARD : STR_SD_CARD, ICON_RADIO_SD_MANAGER)
 {
@@ -322,6 +335,24 @@ void RadioSdManagerPage::build(FormWindow * window)
   browser->refresh();
 }
 
+struct SdCopyDialogProgress {
+  ProgressDialog* dialog;
+  const char* name;
+  int percentage;
+};
+
+// the dialog is only refreshed when the percentage changes
+static bool updateCopyProgress(uint32_t copied, uint32_t total, void* ctx)
+{
+  auto progress = (SdCopyDialogProgress*)ctx;
+  int percentage = total ? (uint64_t)copied * 100 / total : 100;
+  if (percentage != progress->percentage && percentage < 100) {
+    progress->percentage = percentage;
+    progress->dialog->updateProgress(progress->name, percentage);
+  }
+  return true;
+}
+
 void RadioSdManagerPage::fileAction(const char* path, const char* name,
                                     const char* fullpath)
 {
@@ -497,17 +528,27 @@ void RadioSdManagerPage::fileAction(const char* path, const char* name,
         f_getcwd((TCHAR*)lfn, FF_MAX_LFN);
         // prevent copying to the same directory with the same name
         char* destNamePtr = clipboard.data.sd.filename;
+        char destFileName[2 * CLIPBOARD_PATH_LEN + 1];
         if (!strcmp(clipboard.data.sd.directory, lfn)) {
-          char destFileName[2 * CLIPBOARD_PATH_LEN + 1];
           destNamePtr =
               strAppend(destFileName, FILE_COPY_PREFIX, CLIPBOARD_PATH_LEN);
           destNamePtr = strAppend(destNamePtr, clipboard.data.sd.filename,
                                   CLIPBOARD_PATH_LEN);
           destNamePtr = destFileName;
         }
-        sdCopyFile(clipboard.data.sd.filename, clipboard.data.sd.directory,
-                   destNamePtr, lfn);
+
+        SdCopyDialogProgress progress = {
+            new ProgressDialog(this, STR_PASTE, [=]() {}),
+            clipboard.data.sd.filename, -1};
+        const char* error = sdCopyFile(
+            clipboard.data.sd.filename, clipboard.data.sd.directory,
+            destNamePtr, lfn, updateCopyProgress, &progress);
+        progress.dialog->updateProgress(progress.name, 100);
+        if (error) {
+          new MessageDialog(this, STR_PASTE, error);
+        }
         clipboard.type = CLIPBOARD_TYPE_NONE;
+        BitmapCache::instance()->clear();
 
         browser->refresh();
       });
@@ -518,6 +559,8 @@ void RadioSdManagerPage::fileAction(const char* path, const char* name,
     });
     menu->addLine(STR_DELETE_FILE, [=]() {
       f_unlink(fullpath);
+      removeNativeSidecar(fullpath);
+      BitmapCache::instance()->invalidate(fullpath);
       browser->refresh();
     });
   }
@@ -22,6 +22,7 @@
 #include "opentx.h"
 #include "tabsgroup.h"
 #include "bitmaps.h"
+#include "bitmap_cache.h"
 #include "theme_manager.h"
 
 #include <memory>
@@ -162,11 +163,8 @@ class Theme480: public OpenTxTheme
 
     void setBackgroundImageFileName(const char *fileName) override
     {
-      // ensure you delete old bitmap
-      if (backgroundBitmap != nullptr)
-        delete backgroundBitmap;
       OpenTxTheme::setBackgroundImageFileName(fileName);  // set the filename
-      backgroundBitmap = BitmapBuffer::loadBitmap(backgroundImageFileName);
+      backgroundBitmap = BitmapCache::instance()->get(backgroundImageFileName);
     }
 
     void load() const override
@@ -175,7 +173,7 @@ class Theme480: public OpenTxTheme
       ThemePersistance::instance()->loadDefaultTheme();
       OpenTxTheme::load();
       if (!backgroundBitmap) {
-        backgroundBitmap = BitmapBuffer::loadBitmap(getFilePath("background.png"));
+        backgroundBitmap = BitmapCache::instance()->get(getFilePath("background.png"));
       }
       update();
     }
@@ -191,7 +189,7 @@ class Theme480: public OpenTxTheme
     {
       if (backgroundBitmap) {
         dc->clear(COLOR_THEME_SECONDARY3);
-        dc->drawBitmap(0, 0, backgroundBitmap);
+        dc->drawBitmap(0, 0, backgroundBitmap.get());
       } else {
         dc->drawSolidFilledRect(0, 0, LCD_W, LCD_H, COLOR_THEME_SECONDARY3);
       }
@@ -280,7 +278,7 @@ class Theme480: public OpenTxTheme
 
   protected:
     static bool iconsLoaded;
-    static const BitmapBuffer * backgroundBitmap;
+    static SharedBitmap backgroundBitmap;
     static BitmapBuffer * topleftBitmap;
     static BitmapBuffer * menuIconNormal[MENUS_ICONS_COUNT];
     static BitmapBuffer * menuIconSelected[MENUS_ICONS_COUNT];
@@ -290,7 +288,7 @@ class Theme480: public OpenTxTheme
 
 bool Theme480::iconsLoaded = false;
 
-const BitmapBuffer * Theme480::backgroundBitmap = nullptr;
+SharedBitmap Theme480::backgroundBitmap;
 BitmapBuffer * Theme480::topleftBitmap = nullptr;
 BitmapBuffer * Theme480::iconMask[MENUS_ICONS_COUNT] = { nullptr };
 BitmapBuffer * Theme480::menuIconNormal[MENUS_ICONS_COUNT] = { nullptr };
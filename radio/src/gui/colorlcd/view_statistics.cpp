@@ -75,7 +75,7 @@ class DebugInfoNumber : public Window
     }
     new DynamicNumber<uint32_t>(this,
                                 {prefixSize, 0, rect.w - prefixSize, rect.h},
-                                numberHandler, COLOR_THEME_PRIMARY1);
+                                numberHandler, textFlags);
   }
 
  protected:
@@ -261,6 +261,15 @@ void DebugViewPage::build(FormWindow* window)
   line = form->newLine(&grid);
   line->padAll(2);
 
+  // Mixer cycles which missed their deadline
+  new StaticText(line, rect_t{}, STR_MIXER_LATE, 0, COLOR_THEME_PRIMARY1);
+  new DynamicNumber<uint16_t>(
+      line, rect_t{}, [] { return mixerTimingStats.deadlineMisses(); },
+      COLOR_THEME_PRIMARY1);
+
+  line = form->newLine(&grid);
+  line->padAll(2);
+
   // Free mem
   static std::string pad_STR_BYTES = " " + std::string(STR_BYTES);
   new StaticText(line, rect_t{}, STR_FREE_MEM_LABEL, 0, COLOR_THEME_PRIMARY1);
@@ -342,6 +351,29 @@ void DebugViewPage::build(FormWindow* window)
       [] { return audioStack.available(); }, COLOR_THEME_PRIMARY1,
       STR_STACK_AUDIO, nullptr);
 
+  line = form->newLine(&grid);
+  line->padAll(2);
+
+  // CPU load (0.1%)
+  new StaticText(line, rect_t{}, STR_CPU_LOAD, 0, COLOR_THEME_PRIMARY1);
+#if LCD_H > LCD_W
+  line = form->newLine(&grid2);
+  line->padAll(0);
+  line->padLeft(10);
+#endif
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return getTaskCpuLoad(TASK_MENUS); }, COLOR_THEME_PRIMARY1 | PREC1,
+      STR_STACK_MENU, nullptr);
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return getTaskCpuLoad(TASK_MIXER); }, COLOR_THEME_PRIMARY1 | PREC1,
+      STR_STACK_MIX, nullptr);
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] { return getTaskCpuLoad(TASK_AUDIO); }, COLOR_THEME_PRIMARY1 | PREC1,
+      STR_STACK_AUDIO, nullptr);
+
 #if defined(DEBUG_LATENCY)
   line = form->newLine(&grid2);
   line->padAll(2);
@@ -387,6 +419,7 @@ void DebugViewPage::build(FormWindow* window)
   auto btn = new TextButton(line, rect_t{0, 0, 0, 24}, STR_MENUTORESET,
                             [=]() -> uint8_t {
                               maxMixerDuration = 0;
+                              mixerTimingStats.reset();
 #if defined(LUA)
                               maxLuaInterval = 0;
                               maxLuaDuration = 0;
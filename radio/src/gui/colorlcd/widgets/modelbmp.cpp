@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "widgets_container_impl.h"
+#include "bitmap_cache.h"
 
 #include <memory>
 
@@ -111,7 +112,7 @@ class ModelBitmapWidget: public Widget
 
       buffer->clear();
       if (!filename.empty()) {
-        std::unique_ptr<BitmapBuffer> bitmap(BitmapBuffer::loadBitmap(fullpath.c_str()));
+        auto bitmap = BitmapCache::instance()->get(fullpath.c_str());
         if (!bitmap) {
           TRACE("could not load bitmap '%s'", filename.c_str());
           return;
@@ -78,6 +78,7 @@ enum {
   ITEM_RADIO_HARDWARE_SERIAL_PORT,
   ITEM_RADIO_HARDWARE_SERIAL_PORT_END = ITEM_RADIO_HARDWARE_SERIAL_PORT + MAX_SERIAL_PORTS - 1,
   ITEM_RADIO_HARDWARE_JITTER_FILTER,
+  ITEM_RADIO_HARDWARE_MIXER_DEFER,
   ITEM_RADIO_HARDWARE_RAS,
   ITEM_RADIO_HARDWARE_SPORT_UPDATE_POWER,
   ITEM_RADIO_HARDWARE_DEBUG,
@@ -202,6 +203,7 @@ static void _init_menu_tab_array(uint8_t* tab, size_t len)
   }
   tab[ITEM_RADIO_HARDWARE_SERIAL_PORT_LABEL] = has_serial ? READONLY_ROW : HIDDEN_ROW;
   tab[ITEM_RADIO_HARDWARE_JITTER_FILTER] = 0;
+  tab[ITEM_RADIO_HARDWARE_MIXER_DEFER] = 0;
   tab[ITEM_RADIO_HARDWARE_RAS] = READONLY_ROW;
 
   auto mod_desc = modulePortGetModuleDescription(SPORT_MODULE);
@@ -400,6 +402,12 @@ void menuRadioHardware(event_t event)
                              event);
         break;
 
+      case ITEM_RADIO_HARDWARE_MIXER_DEFER:
+        g_eeGeneral.mixerDeferOnOverrun =
+            editCheckBox(g_eeGeneral.mixerDeferOnOverrun, HW_SETTINGS_COLUMN2,
+                         y, STR_MIXER_DEFER, attr, event);
+        break;
+
       case ITEM_RADIO_HARDWARE_RAS:
 #if defined(HARDWARE_INTERNAL_RAS)
         lcdDrawTextAlignedLeft(y, "RAS");
@@ -182,9 +182,12 @@ inline uint8_t MODULE_CHANNELS_ROWS(int moduleIdx)
       return 0;
   }
 #endif
-  else if (isModuleDSM2(moduleIdx) || isModuleCrossfire(moduleIdx) ||
-             isModuleGhost(moduleIdx) || isModuleSBUS(moduleIdx) ||
-             isModuleDSMP(moduleIdx)) {
+  else if (isModuleCrossfire(moduleIdx)) {
+    // the number of channels is only used by subset frames
+    return g_model.moduleData[moduleIdx].crsf.subsetChannels ? 1 : 0;
+  }
+  else if (isModuleDSM2(moduleIdx) || isModuleGhost(moduleIdx) ||
+             isModuleSBUS(moduleIdx) || isModuleDSMP(moduleIdx)) {
     // fixed number of channels
     return 0;
   } else {
@@ -358,7 +361,7 @@ inline uint8_t MODULE_OPTION_ROW(uint8_t moduleIdx) {
     return TITLE_ROW;
   if(isModuleAFHDS3(moduleIdx))
     return HIDDEN_ROW;
-  if(isModuleGhost(moduleIdx))
+  if(isModuleGhost(moduleIdx) || isModuleCrossfire(moduleIdx))
     return 0;
   return MULTIMODULE_OPTIONS_ROW(moduleIdx);
 }
@@ -371,4 +374,8 @@ const char *getMultiOptionTitle(uint8_t moduleIdx);
 
 const char * writeScreenshot();
 
+#if defined(COLORLCD)
+void screenRecordTask(bool active);
+#endif
+
 #endif // _GUI_COMMON_H_
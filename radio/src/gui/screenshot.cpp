@@ -50,12 +50,48 @@ const uint8_t BMP_HEADER[] = {
   0x11, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-const char * writeScreenshot()
-{
-  FIL bmpFile;
-  UINT written;
-  char filename[42]; // /SCREENSHOTS/screen-2013-01-01-123540.bmp
+// FatFs already buffers a sector in the FIL, this small buffer on the stack
+// only saves one f_write() call per pixel
+constexpr uint32_t SCREENSHOT_BUFFER_SIZE = 64;
+
+struct ScreenshotWriter {
+  FIL file;
+  uint8_t buffer[SCREENSHOT_BUFFER_SIZE];
+  uint32_t count;
+  FRESULT result;
+
+  void put(const void * data, uint32_t size)
+  {
+    auto src = (const uint8_t *)data;
+    while (size > 0 && result == FR_OK) {
+      uint32_t len = min<uint32_t>(size, SCREENSHOT_BUFFER_SIZE - count);
+      memcpy(&buffer[count], src, len);
+      count += len;
+      src += len;
+      size -= len;
+      if (count == SCREENSHOT_BUFFER_SIZE) {
+        flush();
+      }
+    }
+  }
+
+  void flush()
+  {
+    UINT written;
+    if (count > 0 && result == FR_OK) {
+      result = f_write(&file, buffer, count, &written);
+      if (result == FR_OK && written != count) {
+        result = FR_DENIED;
+      }
+    }
+    count = 0;
+  }
+};
 
+// filename must hold /SCREENSHOTS/screen-2013-01-01-123540.bmp
+static const char * getScreenshotFilename(char * filename, const char * prefix,
+                                          const char * ext)
+{
   // check and create folder here
   strcpy(filename, SCREENSHOTS_PATH);
   const char * error = sdCheckAndCreateDirectory(filename);
@@ -64,44 +100,49 @@ const char * writeScreenshot()
   }
 
 #if defined(RTCLOCK)
-  char * tmp = strAppend(&filename[sizeof(SCREENSHOTS_PATH)-1], "/screen");
+  char * tmp = strAppend(&filename[sizeof(SCREENSHOTS_PATH)-1], prefix);
   tmp = strAppendDate(tmp, true);
-  strcpy(tmp, BMP_EXT);
+  strcpy(tmp, ext);
 #endif
 
-  FRESULT result = f_open(&bmpFile, filename, FA_CREATE_ALWAYS | FA_WRITE);
-  if (result != FR_OK) {
-    return SDCARD_ERROR(result);
+  return nullptr;
+}
+
+const char * writeScreenshot()
+{
+  ScreenshotWriter writer;
+  char filename[42]; // /SCREENSHOTS/screen-2013-01-01-123540.bmp
+
+  const char * error = getScreenshotFilename(filename, "/screen", BMP_EXT);
+  if (error) {
+    return error;
   }
 
-  result = f_write(&bmpFile, BMP_HEADER, sizeof(BMP_HEADER), &written);
-  if (result != FR_OK || written != sizeof(BMP_HEADER)) {
-    f_close(&bmpFile);
+  FRESULT result = f_open(&writer.file, filename, FA_CREATE_ALWAYS | FA_WRITE);
+  if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
+  writer.count = 0;
+  writer.result = FR_OK;
+  writer.put(BMP_HEADER, sizeof(BMP_HEADER));
+
 #if defined(COLORLCD)
   lv_img_dsc_t* snapshot = lv_snapshot_take(lv_scr_act(), LV_IMG_CF_TRUE_COLOR);
-  if (!snapshot) { f_close(&bmpFile); return nullptr; }
+  if (!snapshot) { f_close(&writer.file); return nullptr; }
 
   auto w = snapshot->header.w;
   auto h = snapshot->header.h;
+  auto pixels = (const lv_color_t *)snapshot->data;
 
-  for (int y = h - 1; y >= 0; y--) {
-    for (uint32_t x = 0; x < w; x++) {
-
-      lv_color_t pixel = lv_img_buf_get_px_color(snapshot, x, y, {});
-
+  for (int y = h - 1; y >= 0 && writer.result == FR_OK; y--) {
+    const lv_color_t * pixel = &pixels[y * w];
+    for (uint32_t x = 0; x < w; x++, pixel++) {
       uint32_t dst = (0xFF << 24)
-          | (pixel.ch.red << 19)
-          | (pixel.ch.green << 10)
-          | (pixel.ch.blue << 3);
-
-      if (f_write(&bmpFile, &dst, sizeof(dst), &written) != FR_OK || written != sizeof(dst)) {
-        lv_snapshot_free(snapshot);
-        f_close(&bmpFile);
-        return SDCARD_ERROR(result);
-      }
+          | (pixel->ch.red << 19)
+          | (pixel->ch.green << 10)
+          | (pixel->ch.blue << 3);
+      writer.put(&dst, sizeof(dst));
     }
   }
 
@@ -109,18 +150,197 @@ const char * writeScreenshot()
 
 #else // stdlcd
 
-  for (int y=LCD_H-1; y>=0; y-=1) {
+  for (int y=LCD_H-1; y>=0 && writer.result == FR_OK; y-=1) {
     for (int x=0; x<8*((LCD_W+7)/8); x+=2) {
       pixel_t byte = getPixel(x+1, y) + (getPixel(x, y) << 4);
-      if (f_write(&bmpFile, &byte, 1, &written) != FR_OK || written != 1) {
-        f_close(&bmpFile);
-        return SDCARD_ERROR(result);
-      }
+      writer.put(&byte, 1);
     }
   }
 #endif
 
-  f_close(&bmpFile);
+  writer.flush();
+  result = f_close(&writer.file);
+  if (writer.result != FR_OK) {
+    result = writer.result;
+  }
+
+  return result == FR_OK ? nullptr : SDCARD_ERROR(result);
+}
+
+#if defined(COLORLCD)
+// Screen recording, active while its special function switch is ON.
+//
+// The screen is rendered into a buffer every SCREENREC_PERIOD and only the
+// part of each row which changed since the previous frame is written, so
+// a mostly static UI costs a few bytes per frame. Frames are written from
+// the GUI task: large changes lower the frame rate (each frame records its
+// time) but never delay the mixer.
+//
+// File format (little endian), radio/util/screenrec2gif.py converts it:
+//   header: "EREC", u16 version, u16 width, u16 height
+//   frame:  u32 time (ms since start), u16 number of rows
+//   row:    u16 y, u16 x, u16 len, len * u16 RGB565 pixels
+
+constexpr tmr10ms_t SCREENREC_PERIOD = 10; // 10 fps
+constexpr uint16_t SCREENREC_VERSION = 1;
+
+struct ScreenRecorder {
+  ScreenshotWriter writer;
+  uint32_t bufferSize;
+  lv_color_t * frame;
+  lv_color_t * previous;
+  uint16_t spanStart[LCD_H];
+  uint16_t spanLength[LCD_H];
+  tmr10ms_t startTime;
+  tmr10ms_t lastFrameTime;
+  bool hasPrevious;
+
+  void put16(uint16_t value)
+  {
+    writer.put(&value, sizeof(value));
+  }
+
+  void put32(uint32_t value)
+  {
+    writer.put(&value, sizeof(value));
+  }
+
+  bool writeFrame(tmr10ms_t now);
+};
+
+static ScreenRecorder * screenRecorder = nullptr;
+static bool screenRecordFailed = false;
+
+bool ScreenRecorder::writeFrame(tmr10ms_t now)
+{
+  lv_img_dsc_t snapshot;
+  if (lv_snapshot_take_to_buf(lv_scr_act(), LV_IMG_CF_TRUE_COLOR, &snapshot,
+                              frame, bufferSize) != LV_RES_OK ||
+      snapshot.header.w != LCD_W || snapshot.header.h != LCD_H) {
+    return false;
+  }
+
+  uint16_t rows = 0;
+  for (uint16_t y = 0; y < LCD_H; y++) {
+    const lv_color_t * cur = &frame[y * LCD_W];
+    const lv_color_t * prev = &previous[y * LCD_W];
+    uint16_t x0 = 0;
+    uint16_t x1 = LCD_W;
+    if (hasPrevious) {
+      while (x0 < LCD_W && cur[x0].full == prev[x0].full) x0++;
+      while (x1 > x0 && cur[x1 - 1].full == prev[x1 - 1].full) x1--;
+    }
+    spanStart[y] = x0;
+    spanLength[y] = x1 - x0;
+    if (x1 > x0) rows++;
+  }
+
+  put32((now - startTime) * 10);
+  put16(rows);
+  for (uint16_t y = 0; y < LCD_H && rows > 0; y++) {
+    uint16_t len = spanLength[y];
+    if (len == 0) continue;
+    put16(y);
+    put16(spanStart[y]);
+    put16(len);
+    const lv_color_t * pixel = &frame[y * LCD_W + spanStart[y]];
+    for (uint16_t x = 0; x < len; x++, pixel++) {
+      put16(lv_color_to16(*pixel));
+    }
+  }
+
+  std::swap(frame, previous);
+  hasPrevious = true;
+  return writer.result == FR_OK;
+}
+
+static void stopScreenRecord()
+{
+  ScreenRecorder * rec = screenRecorder;
+  screenRecorder = nullptr;
+
+  rec->writer.flush();
+  f_close(&rec->writer.file);
+  free(rec->frame);
+  free(rec->previous);
+  delete rec;
+}
+
+static const char * startScreenRecord()
+{
+  char filename[42]; // /SCREENSHOTS/record-2013-01-01-123540.rec
+  const char * error = getScreenshotFilename(filename, "/record", SCREENREC_EXT);
+  if (error) {
+    return error;
+  }
+
+  auto rec = new ScreenRecorder;
+  if (!rec) {
+    return SDCARD_ERROR(FR_NOT_ENOUGH_CORE);
+  }
+
+  rec->bufferSize = lv_snapshot_buf_size_needed(lv_scr_act(), LV_IMG_CF_TRUE_COLOR);
+  rec->frame = (lv_color_t *)malloc(rec->bufferSize);
+  rec->previous = (lv_color_t *)malloc(rec->bufferSize);
+  rec->hasPrevious = false;
+  rec->writer.count = 0;
+  rec->writer.result = FR_NOT_ENOUGH_CORE;
+  if (rec->frame && rec->previous) {
+    rec->writer.result = f_open(&rec->writer.file, filename, FA_CREATE_ALWAYS | FA_WRITE);
+  }
+
+  if (rec->writer.result != FR_OK) {
+    FRESULT result = rec->writer.result;
+    free(rec->frame);
+    free(rec->previous);
+    delete rec;
+    return SDCARD_ERROR(result);
+  }
+
+  rec->writer.put("EREC", 4);
+  rec->put16(SCREENREC_VERSION);
+  rec->put16(LCD_W);
+  rec->put16(LCD_H);
+  rec->startTime = rec->lastFrameTime = get_tmr10ms();
+  screenRecorder = rec;
 
   return nullptr;
 }
+
+void screenRecordTask(bool active)
+{
+  if (!active) {
+    if (screenRecorder) {
+      stopScreenRecord();
+    }
+    screenRecordFailed = false;
+    return;
+  }
+
+  if (screenRecordFailed) {
+    // wait for the switch to be turned OFF before trying again
+    return;
+  }
+
+  if (!screenRecorder) {
+    const char * error = startScreenRecord();
+    if (error) {
+      TRACE("Screen record: %s", error);
+      screenRecordFailed = true;
+      return;
+    }
+  }
+
+  tmr10ms_t now = get_tmr10ms();
+  if (screenRecorder->hasPrevious && now - screenRecorder->lastFrameTime < SCREENREC_PERIOD) {
+    return;
+  }
+
+  screenRecorder->lastFrameTime = now;
+  if (!screenRecorder->writeFrame(now)) {
+    TRACE("Screen record: write failed");
+    screenRecordFailed = true;
+    stopScreenRecord();
+  }
+}
+#endif
@@ -370,10 +370,41 @@ const char *FrskyDeviceFirmwareUpdate::doFlashFirmware(
   return result;
 }
 
+// Horus XJT block: request answer (2 bytes) + data + CRC (2 bytes)
+#define XJT_BLOCK_SIZE       1024
+#define XJT_BLOCK_HEADER     2
+
+bool FrskyDeviceFirmwareUpdate::readHorusXJTBlock(FIL * file, uint8_t * block, uint8_t index, UINT * count)
+{
+  uint8_t * data = block + XJT_BLOCK_HEADER;
+  if (f_read(file, data, XJT_BLOCK_SIZE, count) != FR_OK) {
+    return false;
+  }
+
+  if (*count < XJT_BLOCK_SIZE)
+    memset(data + *count, 0, XJT_BLOCK_SIZE - *count);
+
+  block[0] = 0x11 + 0x80;
+  block[1] = index;
+
+  uint16_t crc_16 = crc16(CRC_1189, data, XJT_BLOCK_SIZE, crc16(CRC_1189, &block[1], 1));
+  data[XJT_BLOCK_SIZE] = crc_16 >> 8;
+  data[XJT_BLOCK_SIZE + 1] = crc_16;
+  return true;
+}
+
+void FrskyDeviceFirmwareUpdate::waitTxCompleted()
+{
+  if (uart_drv->waitForTxCompleted) {
+    uart_drv->waitForTxCompleted(uart_ctx);
+  }
+}
+
 const char *FrskyDeviceFirmwareUpdate::uploadFileToHorusXJT(
     const char *filename, FIL *file, ProgressHandler progressHandler)
 {
-  uint32_t buffer[1024 / sizeof(uint32_t)];
+  // the next block is read from the file while the current one is sent
+  uint8_t blocks[2][XJT_BLOCK_HEADER + XJT_BLOCK_SIZE + 2];
   UINT count;
   uint8_t frame[8];
 
@@ -392,12 +423,13 @@ const char *FrskyDeviceFirmwareUpdate::uploadFileToHorusXJT(
   readBuffer(frame, 1, 100);
 
   uint8_t index = 0;
-  while (true) {
-    progressHandler(getBasename(filename), STR_WRITING, file->fptr, file->obj.objsize);
+  uint8_t current = 0;
+  if (!readHorusXJTBlock(file, blocks[current], index, &count)) {
+    return STR_DEVICE_FILE_ERROR;
+  }
 
-    if (f_read(file, buffer, 1024, &count) != FR_OK) {
-      return STR_DEVICE_FILE_ERROR;
-    }
+  while (true) {
+    progressHandler(getBasename(filename), STR_WRITING, file->fptr - count, file->obj.objsize);
 
     if (!readBuffer(frame, 2, 100))
         return STR_DEVICE_DATA_REFUSED;
@@ -405,30 +437,27 @@ const char *FrskyDeviceFirmwareUpdate::uploadFileToHorusXJT(
     if (frame[0] != 0x11 || frame[1] != index)
         return STR_DEVICE_WRONG_REQUEST;
 
+    // the previous block is fully sent once the next one is requested
+    waitTxCompleted();
+
     if (count == 0) {
       uart_drv->sendByte(uart_ctx, 0xA1);
       RTOS_WAIT_MS(50);
       return nullptr;
     }
 
-    if (count < 1024)
-      memset(((uint8_t *)buffer) + count, 0, 1024 - count);
-
-    uart_drv->sendByte(uart_ctx, frame[0] + 0x80);
-    uart_drv->sendByte(uart_ctx, frame[1]);
-
-    uint16_t crc_16 = crc16(CRC_1189, (uint8_t *)buffer, 1024, crc16(CRC_1189, &frame[1], 1));
-    for (size_t i = 0; i < sizeof(buffer); i++) {
-      uart_drv->sendByte(uart_ctx, ((uint8_t *)buffer)[i]);
-    }
-    uart_drv->sendByte(uart_ctx, crc_16 >> 8);
-    uart_drv->sendByte(uart_ctx, crc_16);
+    uart_drv->sendBuffer(uart_ctx, blocks[current], sizeof(blocks[current]));
 
     index++;
+    current ^= 1;
+    if (!readHorusXJTBlock(file, blocks[current], index, &count)) {
+      waitTxCompleted();
+      return STR_DEVICE_FILE_ERROR;
+    }
   }
 }
 
-void FrskyDeviceFirmwareUpdate::sendDataTransfer(uint32_t* buffer)
+void FrskyDeviceFirmwareUpdate::sendDataTransfer(const uint32_t* buffer)
 {
   startFrame(PRIM_DATA_WORD);
   uint32_t offset = (address & 1023) >> 2; // 32 bit word offset into buffer
@@ -441,7 +470,11 @@ void FrskyDeviceFirmwareUpdate::sendDataTransfer(uint32_t* buffer)
 const char *FrskyDeviceFirmwareUpdate::uploadFileNormal(
     const char *filename, FIL *file, ProgressHandler progressHandler)
 {
-  uint32_t buffer[1024 / sizeof(uint32_t)];
+  // the previous block is kept, in case the device asks for its last words
+  // again once the next block has been read
+  uint32_t buffer[2][1024 / sizeof(uint32_t)];
+  uint32_t blockAddress[2] = { UINT32_MAX, UINT32_MAX };
+  uint8_t current = 1;
   UINT count;
 
   const char * result = sendPowerOn();
@@ -462,9 +495,12 @@ const char *FrskyDeviceFirmwareUpdate::uploadFileNormal(
   uint8_t retries = 0;
 
   while (true) {
-    if (f_read(file, buffer, 1024, &count) != FR_OK) {
+    // read while the device is handling the last word sent
+    current ^= 1;
+    if (f_read(file, buffer[current], 1024, &count) != FR_OK) {
         return STR_DEVICE_FILE_ERROR;
     }
+    blockAddress[current] = UINT32_MAX;
 
     count >>= 2;
 
@@ -479,7 +515,14 @@ const char *FrskyDeviceFirmwareUpdate::uploadFileNormal(
         return STR_DEVICE_DATA_REFUSED;
       }
 
-      sendDataTransfer(buffer);
+      uint32_t requested = address & ~1023;
+      if (requested == blockAddress[current ^ 1]) {
+        sendDataTransfer(buffer[current ^ 1]);
+      }
+      else {
+        blockAddress[current] = requested;
+        sendDataTransfer(buffer[current]);
+      }
 
       if (i == 0) {
         progressHandler(getBasename(filename), STR_WRITING, file->fptr, file->obj.objsize);
@@ -149,13 +149,15 @@ class FrskyDeviceFirmwareUpdate {
     const uint8_t * readFrame(uint32_t timeout);
     bool waitState(State state, uint32_t timeout);
     void processFrame(const uint8_t * frame);
-    void sendDataTransfer(uint32_t* buffer);
+    void sendDataTransfer(const uint32_t* buffer);
+    void waitTxCompleted();
 
     const char * doFlashFirmware(const char * filename, ProgressHandler progressHandler);
     const char * sendPowerOn();
     const char * sendReqVersion();
     const char * uploadFileNormal(const char * filename, FIL * file, ProgressHandler progressHandler);
     const char * uploadFileToHorusXJT(const char * filename, FIL * file, ProgressHandler progressHandler);
+    bool readHorusXJTBlock(FIL * file, uint8_t * block, uint8_t index, UINT * count);
     const char * endTransfer();
 };
 
@@ -47,6 +47,10 @@
 
 #define UPDATE_MULTI_EXT_BIN ".bin"
 
+// STK_PROG_PAGE, size (2 bytes), memory type / CRC_EOP
+#define PAGE_HEADER_SIZE     4
+#define PAGE_FOOTER_SIZE     1
+
 class MultiFirmwareUpdateDriver
 {
   ModuleIndex module;
@@ -58,6 +62,7 @@ class MultiFirmwareUpdateDriver
   bool getByte(uint8_t& byte) const;
   void sendByte(uint8_t byte) const;
   void sendBuffer(uint8_t* buffer, uint16_t size) const;
+  void waitTxCompleted() const;
   void clear() const;
   void deinit();
 
@@ -66,7 +71,8 @@ class MultiFirmwareUpdateDriver
   const char* waitForInitialSync();
   const char* getDeviceSignature(uint8_t* signature) const;
   const char* loadAddress(uint32_t offset) const;
-  const char* progPage(uint8_t* buffer, uint16_t size) const;
+  void sendPage(uint8_t* page, uint16_t size) const;
+  const char* waitPageWritten() const;
   void leaveProgMode();
 
  public:
@@ -137,6 +143,8 @@ void MultiFirmwareUpdateDriver::sendByte(uint8_t byte) const
   drv->sendByte(ctx, byte);
 }
 
+// does not wait for the buffer to be sent: call waitTxCompleted()
+// before modifying it
 void MultiFirmwareUpdateDriver::sendBuffer(uint8_t* buffer, uint16_t size) const
 {
   auto drv = modulePortGetSerialDrv(mod_st->tx);
@@ -144,6 +152,12 @@ void MultiFirmwareUpdateDriver::sendBuffer(uint8_t* buffer, uint16_t size) const
 
   drv->waitForTxCompleted(ctx);
   drv->sendBuffer(ctx, buffer, size);
+}
+
+void MultiFirmwareUpdateDriver::waitTxCompleted() const
+{
+  auto drv = modulePortGetSerialDrv(mod_st->tx);
+  auto ctx = modulePortGetCtx(mod_st->tx);
   drv->waitForTxCompleted(ctx);
 }
 
@@ -269,20 +283,27 @@ const char * MultiFirmwareUpdateDriver::loadAddress(uint32_t offset) const
   return nullptr;
 }
 
-const char * MultiFirmwareUpdateDriver::progPage(uint8_t * buffer, uint16_t size) const
+// 'page' holds the page data at PAGE_HEADER_SIZE, with room for the
+// PAGE_FOOTER_SIZE bytes after it, so that the whole command is sent at once
+void MultiFirmwareUpdateDriver::sendPage(uint8_t * page, uint16_t size) const
 {
-  sendByte(STK_PROG_PAGE);
+  page[0] = STK_PROG_PAGE;
 
   // page size
-  sendByte(size >> 8);
-  sendByte(size & 0xFF);
+  page[1] = size >> 8;
+  page[2] = size & 0xFF;
 
   // flash/eeprom flag
-  sendByte(0);
+  page[3] = 0;
 
-  sendBuffer(buffer, size);
+  page[PAGE_HEADER_SIZE + size] = CRC_EOP;
 
-  sendByte(CRC_EOP);
+  sendBuffer(page, PAGE_HEADER_SIZE + size + PAGE_FOOTER_SIZE);
+}
+
+const char * MultiFirmwareUpdateDriver::waitPageWritten() const
+{
+  waitTxCompleted();
 
   if (!checkRxByte(STK_INSYNC))
     return STR_DEVICE_NO_RESPONSE;
@@ -342,7 +363,8 @@ const char* MultiFirmwareUpdateDriver::flashFirmware(
     return result;
   }
 
-  uint8_t buffer[256];
+  // two pages: the next one is read while the current one is sent and written
+  uint8_t pages[2][PAGE_HEADER_SIZE + 256 + PAGE_FOOTER_SIZE];
   uint16_t pageSize = 128;
   uint32_t writeOffset = 0;
 
@@ -356,18 +378,16 @@ const char* MultiFirmwareUpdateDriver::flashFirmware(
     writeOffset = 0x1000; // start offset (word address)
   }
 
-  while (!f_eof(file)) {
-    progressHandler(label, STR_WRITING, file->fptr, file->obj.objsize);
-
-    UINT count = 0;
-    memclear(buffer, pageSize);
-    if (f_read(file, buffer, pageSize, &count) != FR_OK) {
-      result = STR_DEVICE_FILE_ERROR;
-      break;
-    }
+  uint8_t current = 0;
+  UINT count = 0;
+  memclear(pages[current] + PAGE_HEADER_SIZE, pageSize);
+  if (f_read(file, pages[current] + PAGE_HEADER_SIZE, pageSize, &count) != FR_OK) {
+    result = STR_DEVICE_FILE_ERROR;
+    count = 0;
+  }
 
-    if (!count)
-      break;
+  while (count) {
+    progressHandler(label, STR_WRITING, file->fptr - count, file->obj.objsize);
 
     clear();
 
@@ -376,12 +396,25 @@ const char* MultiFirmwareUpdateDriver::flashFirmware(
       break;
     }
 
-    result = progPage(buffer, pageSize);
+    sendPage(pages[current], pageSize);
+
+    UINT next = 0;
+    uint8_t * nextPage = pages[current ^ 1] + PAGE_HEADER_SIZE;
+    memclear(nextPage, pageSize);
+    if (!f_eof(file) && f_read(file, nextPage, pageSize, &next) != FR_OK) {
+      waitTxCompleted();
+      result = STR_DEVICE_FILE_ERROR;
+      break;
+    }
+
+    result = waitPageWritten();
     if (result) {
       break;
     }
 
     writeOffset += pageSize / 2;
+    count = next;
+    current ^= 1;
   }
 
   if (f_eof(file)) {
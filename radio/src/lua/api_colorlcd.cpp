@@ -23,10 +23,12 @@
 
 #include <cctype>
 #include <cstdio>
+#include <new>
 
 #include "opentx.h"
 #include "libopenui.h"
 #include "widget.h"
+#include "bitmap_cache.h"
 
 #include "lua_api.h"
 #include "api_colorlcd.h"
@@ -530,30 +532,59 @@ Bitmap loading can fail if:
 
 @status current Introduced in 2.2.0
 */
+// Bitmap userdata holds a reference on a (possibly cached and shared) bitmap.
+// Bitmaps loaded through the cache are accounted for by the cache; only the
+// ones owned by Lua (resized copies, and images loaded while the cache is
+// full) are added to luaExtraMemoryUsage.
+struct LuaBitmap {
+  SharedBitmap bitmap;
+  uint32_t extraMemory;
+};
+
+static LuaBitmap * newBitmap(lua_State * L)
+{
+  void * ud = lua_newuserdata(L, sizeof(LuaBitmap));
+  return new (ud) LuaBitmap{nullptr, 0};
+}
+
 static int luaOpenBitmap(lua_State *L)
 {
   const char *filename = luaL_checkstring(L, 1);
 
-  BitmapBuffer **b =
-      (BitmapBuffer **)lua_newuserdata(L, sizeof(BitmapBuffer *));
+  LuaBitmap *b = newBitmap(L);
+  BitmapCache * cache = BitmapCache::instance();
 
-  if (luaExtraMemoryUsage > LUA_MEM_EXTRA_MAX) {
+  if (cache->isFull() && G(L)->gcrunning) {
+    luaC_fullgc(L, 1);  /* release the bitmaps not referenced anymore */
+  }
+
+  if (!cache->isFull()) {
+    b->bitmap = cache->get(filename);
+    if (!b->bitmap && G(L)->gcrunning) {
+      luaC_fullgc(L, 1);              /* try to free some memory... */
+      b->bitmap = cache->get(filename); /* try again */
+    }
+    if (b->bitmap) {
+      TRACE("luaOpenBitmap: %p (cache %u/%u)", b->bitmap.get(),
+            cache->getUsage(), cache->getBudget());
+    }
+  } else if (luaExtraMemoryUsage > LUA_MEM_EXTRA_MAX) {
     // already allocated more than max allowed, fail
     TRACE("luaOpenBitmap: Error, using too much memory %u/%u",
           luaExtraMemoryUsage, LUA_MEM_EXTRA_MAX);
-    *b = 0;
   } else {
-    *b = BitmapBuffer::loadBitmap(filename);
-    if (*b == NULL && G(L)->gcrunning) {
-      luaC_fullgc(L, 1);                       /* try to free some memory... */
-      *b = BitmapBuffer::loadBitmap(filename); /* try again */
+    // the cache is full of bitmaps in use: load a copy owned by Lua
+    BitmapBuffer * bitmap = BitmapBuffer::loadBitmap(filename);
+    if (!bitmap && G(L)->gcrunning) {
+      luaC_fullgc(L, 1);              /* try to free some memory... */
+      bitmap = BitmapBuffer::loadBitmap(filename); /* try again */
+    }
+    if (bitmap) {
+      b->bitmap.reset(bitmap);
+      b->extraMemory = bitmap->getDataSize();
+      luaExtraMemoryUsage += b->extraMemory;
+      TRACE("luaOpenBitmap: %p (%u)", bitmap, b->extraMemory);
     }
-  }
-
-  if (*b) {
-    uint32_t size = (*b)->getDataSize();
-    luaExtraMemoryUsage += size;
-    TRACE("luaOpenBitmap: %p (%u)", *b, size);
   }
 
   luaL_getmetatable(L, BITMAP_METATABLE);
@@ -562,10 +593,10 @@ static int luaOpenBitmap(lua_State *L)
   return 1;
 }
 
-static BitmapBuffer * checkBitmap(lua_State * L, int index)
+static const BitmapBuffer * checkBitmap(lua_State * L, int index)
 {
-  BitmapBuffer ** b = (BitmapBuffer **)luaL_checkudata(L, index, BITMAP_METATABLE);
-  return *b;
+  LuaBitmap * b = (LuaBitmap *)luaL_checkudata(L, index, BITMAP_METATABLE);
+  return b->bitmap.get();
 }
 
 /*luadoc
@@ -623,23 +654,23 @@ static int luaBitmapResize(lua_State * L)
     return 1;
   }
 
-  BitmapBuffer **n = (BitmapBuffer**)lua_newuserdata(L, sizeof(BitmapBuffer*));
+  LuaBitmap *n = newBitmap(L);
 
   if (luaExtraMemoryUsage > LUA_MEM_EXTRA_MAX) {
     // already allocated more than max allowed, fail
     TRACE("luaOpenBitmap: Error, using too much memory %u/%u",
           luaExtraMemoryUsage, LUA_MEM_EXTRA_MAX);
-    *n = 0;
   } else {
-    *n = new BitmapBuffer(BMP_ARGB4444, w, h);
-    (*n)->clear();
-    (*n)->drawScaledBitmap(b, 0, 0, w, h);
+    BitmapBuffer *resized = new BitmapBuffer(BMP_ARGB4444, w, h);
+    resized->clear();
+    resized->drawScaledBitmap(b, 0, 0, w, h);
+    n->bitmap.reset(resized);
   }
 
-  if (*n) {
-    uint32_t size = (*n)->getDataSize();
-    luaExtraMemoryUsage += size;
-    TRACE("luaResizeBitmap: %p (%u)", *n, size);
+  if (n->bitmap) {
+    n->extraMemory = n->bitmap->getDataSize();
+    luaExtraMemoryUsage += n->extraMemory;
+    TRACE("luaResizeBitmap: %p (%u)", n->bitmap.get(), n->extraMemory);
   }
 
   luaL_getmetatable(L, BITMAP_METATABLE);
@@ -677,18 +708,17 @@ static int luaBitmapTo8bitMask(lua_State * L)
 
 static int luaDestroyBitmap(lua_State * L)
 {
-  BitmapBuffer * b = checkBitmap(L, 1);
-  if (b) {
-    uint32_t size = b->getDataSize();
-    TRACE("luaDestroyBitmap: %p (%u)", b, size);
-    if (luaExtraMemoryUsage >= size) {
-      luaExtraMemoryUsage -= size;
+  LuaBitmap * b = (LuaBitmap *)luaL_checkudata(L, 1, BITMAP_METATABLE);
+  if (b->bitmap) {
+    TRACE("luaDestroyBitmap: %p (%u)", b->bitmap.get(), b->extraMemory);
+    if (luaExtraMemoryUsage >= b->extraMemory) {
+      luaExtraMemoryUsage -= b->extraMemory;
     }
     else {
       luaExtraMemoryUsage = 0;
     }
-    delete b;
   }
+  b->~LuaBitmap();
   return 0;
 }
 
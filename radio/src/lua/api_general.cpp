@@ -31,6 +31,7 @@
 #include "hal/adc_driver.h"
 #include "hal/rotary_encoder.h"
 #include "switches.h"
+#include "tasks.h"
 #include "input_mapping.h"
 
 #if defined(LIBOPENUI)
@@ -2096,6 +2097,31 @@ static int luaGetAvailableMemory(lua_State * L)
   return 1;
 }
 
+/*luadoc
+@function getTasksInfo()
+
+Get the CPU load and the free stack of the radio tasks.
+
+@retval table indexed by task name (`menus`, `mixer`, `audio`, `cli`, `timer`, `idle`),
+each entry containing:
+ * `load` (number) CPU time used during the last second, in 0.1%
+ * `stack` (number) stack high-water mark, in bytes
+
+@status current Introduced in 2.10.0
+*/
+static int luaGetTasksInfo(lua_State * L)
+{
+  lua_newtable(L);
+  for (uint8_t i = 0; i < TASK_COUNT; i++) {
+    lua_pushstring(L, getTaskName(i));
+    lua_newtable(L);
+    lua_pushtableinteger(L, "load", getTaskCpuLoad(i));
+    lua_pushtableinteger(L, "stack", getTaskStackAvailable(i));
+    lua_settable(L, -3);
+  }
+  return 1;
+}
+
 /*luadoc
 @function resetGlobalTimer([type])
 
@@ -2817,6 +2843,7 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( loadScript, luaLoadScript )
   LROT_FUNCENTRY( getUsage, luaGetUsage )
   LROT_FUNCENTRY( getAvailableMemory, luaGetAvailableMemory )
+  LROT_FUNCENTRY( getTasksInfo, luaGetTasksInfo )
   LROT_FUNCENTRY( resetGlobalTimer, luaResetGlobalTimer )
 #if LCD_DEPTH > 1 && !defined(COLORLCD)
   LROT_FUNCENTRY( GREY, luaGrey )
@@ -2968,6 +2995,7 @@ LROT_BEGIN(etxcst, NULL, 0)
 #if defined(COLORLCD)
   LROT_NUMENTRY( FUNC_DISABLE_TOUCH, FUNC_DISABLE_TOUCH )
   LROT_NUMENTRY( FUNC_SET_SCREEN, FUNC_SET_SCREEN )
+  LROT_NUMENTRY( FUNC_SCREEN_RECORD, FUNC_SCREEN_RECORD )
 
   LROT_NUMENTRY( SHADOWED, SHADOWED )
   LROT_NUMENTRY( COLOR, ZoneOption::Color )
@@ -1236,6 +1236,7 @@ static bool resumeLua(bool init, bool allowLcdUsage)
 
 bool luaTask(event_t evt, bool allowLcdUsage)
 {
+  TRACE_EVENT_SCOPE(trace_lua);
   bool init = false;
   bool scriptWasRun = false;
  
@@ -21,17 +21,23 @@
 
 #include "opentx.h"
 #include "hal/adc_driver.h"
+#include "tasks.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
   #include "gui/colorlcd/LvglWrapper.h"
   #include "gui/colorlcd/view_main.h"
+  #include "gui/colorlcd/bitmap_cache.h"
 #endif
 
 #if defined(CLI)
   #include "cli.h"
 #endif
 
+#if defined(STORAGE_MODELSLIST)
+  #include "storage/modelslist.h"
+#endif
+
 uint8_t currentSpeakerVolume = 255;
 uint8_t requiredSpeakerVolume = 255;
 uint8_t currentBacklightBright = 0;
@@ -175,6 +181,10 @@ void handleUsbConnection()
     usbStop();
     TRACE("USB stopped");
     if (getSelectedUsbMode() == USB_MASS_STORAGE_MODE) {
+#if defined(LIBOPENUI)
+      // images may have been replaced on the SD card
+      BitmapCache::instance()->clear();
+#endif
       opentxResume();
       pushEvent(EVT_ENTRY);
     } else if (getSelectedUsbMode() == USB_SERIAL_MODE) {
@@ -288,6 +298,11 @@ void checkEeprom()
   if (TIME_TO_WRITE()) {
     storageCheck(false);
   }
+#if defined(STORAGE_MODELSLIST)
+  else if (!storageDirtyMsk) {
+    modelslist.checkPendingLabels();
+  }
+#endif
 }
 #endif
 
@@ -327,6 +342,7 @@ void checkBattery()
 void periodicTick_1s()
 {
   checkBattery();
+  tasksUpdateCpuLoad();
 }
 
 void periodicTick_10s()
@@ -394,6 +410,8 @@ void guiMain(event_t evt)
     writeScreenshot();
     mainRequestFlags &= ~(1u << REQUEST_SCREENSHOT);
   }
+
+  screenRecordTask(isFunctionActive(FUNCTION_SCREEN_RECORD));
 }
 #elif defined(GUI)
 
@@ -87,6 +87,21 @@ int16_t cyc_anas[3] = {0};
  f(x) = (k*x*x*x/(1024*1024) + x*(256-k) + 128) / 256
  */
 
+// calc100to256(k) for k 0 to 100, saves a division on each expo() call
+static const uint16_t expoK256[] = {
+    0,   3,   5,   8,  10,  13,  15,  18,  20,  23,
+   26,  28,  31,  33,  36,  38,  41,  44,  46,  49,
+   51,  54,  56,  59,  61,  64,  67,  69,  72,  74,
+   77,  79,  82,  84,  87,  90,  92,  95,  97, 100,
+  102, 105, 108, 110, 113, 115, 118, 120, 123, 125,
+  128, 131, 133, 136, 138, 141, 143, 146, 148, 151,
+  154, 156, 159, 161, 164, 166, 169, 172, 174, 177,
+  179, 182, 184, 187, 189, 192, 195, 197, 200, 202,
+  205, 207, 210, 212, 215, 218, 220, 223, 225, 228,
+  230, 233, 236, 238, 241, 243, 246, 248, 251, 253,
+  256,
+};
+
 // input parameters;
 //  x 0 to 1024;
 //  k 0 to 100;
@@ -104,7 +119,7 @@ unsigned int expou(unsigned int x, unsigned int k)
   }
 #endif
 
-  k = calc100to256(k);
+  k = (k < DIM(expoK256) ? expoK256[k] : calc100to256(k));
 
   uint32_t value = (uint32_t) x*x;
   value *= (uint32_t)k;
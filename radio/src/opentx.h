@@ -308,6 +308,21 @@ struct CustomFunctionsContext {
   MASK_CFN_TYPE  activeSwitches;
   tmr10ms_t lastFunctionTime[MAX_SPECIAL_FUNCTIONS];
 
+  // indexes of the functions which have a switch, rebuilt after any change:
+  // the level triggered ones are evaluated at each tick, the others are
+  // grouped by switch and only evaluated on a switch change or a repeat
+  bool compiled;
+  uint8_t levelCount;
+  uint8_t level[MAX_SPECIAL_FUNCTIONS];
+  uint8_t triggerCount;
+  uint8_t trigger[MAX_SPECIAL_FUNCTIONS];
+  uint8_t groupCount;
+  uint8_t groupStart[MAX_SPECIAL_FUNCTIONS + 1];
+  MASK_CFN_TYPE triggerMask;   // one bit per function
+  MASK_CFN_TYPE groupActive;   // one bit per group
+  MASK_CFN_TYPE groupRepeat;   // one bit per group with a deadline
+  tmr10ms_t groupDeadline[MAX_SPECIAL_FUNCTIONS];
+
   inline bool isFunctionActive(uint8_t func)
   {
     return activeFunctions & ((MASK_FUNC_TYPE)1 << func);
@@ -672,6 +687,9 @@ enum FunctionsActive {
 #if defined(HARDWARE_TOUCH)
   FUNCTION_DISABLE_TOUCH,
 #endif
+#if defined(COLORLCD)
+  FUNCTION_SCREEN_RECORD,
+#endif
 };
 
 #define VARIO_FREQUENCY_ZERO   700/*Hz*/
@@ -692,6 +710,13 @@ inline void customFunctionsReset()
   modelFunctionsContext.reset();
 }
 
+// to be called when the functions of the model or of the radio change
+inline void customFunctionsChanged()
+{
+  globalFunctionsContext.compiled = false;
+  modelFunctionsContext.compiled = false;
+}
+
 const char* funcGetLabel(uint8_t func);
 
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Channels packed as consecutive fixed width values, LSB first
+// (SBUS, CRSF, Multi, Ghost...).
+//
+// The width is a template parameter, so that masks and shifts are constants
+// and loops over a constant number of channels can be unrolled.
+
+template <uint8_t BITS>
+class ChannelsPacker
+{
+  static_assert(BITS > 0 && BITS <= 24, "ChannelsPacker: unsupported width");
+
+  public:
+    explicit ChannelsPacker(uint8_t *& buffer):
+      buffer(buffer)
+    {
+    }
+
+    ~ChannelsPacker()
+    {
+      flush();
+    }
+
+    // value must be in [0 : (1 << BITS) - 1]
+    inline void push(uint32_t value)
+    {
+      bits |= value << available;
+      available += BITS;
+      while (available >= 8) {
+        *buffer++ = bits;
+        bits >>= 8;
+        available -= 8;
+      }
+    }
+
+    // write the remaining bits, if any
+    inline void flush()
+    {
+      if (available > 0) {
+        *buffer++ = bits;
+        bits = 0;
+        available = 0;
+      }
+    }
+
+  protected:
+    uint8_t *& buffer;
+    uint32_t bits = 0;
+    uint8_t available = 0;
+};
+
+template <uint8_t BITS>
+class ChannelsUnpacker
+{
+  static_assert(BITS > 0 && BITS <= 24, "ChannelsUnpacker: unsupported width");
+
+  public:
+    static constexpr uint32_t MASK = (1u << BITS) - 1;
+
+    explicit ChannelsUnpacker(const uint8_t * buffer):
+      buffer(buffer)
+    {
+    }
+
+    inline uint32_t pop()
+    {
+      while (available < BITS) {
+        bits |= (uint32_t)*buffer++ << available;
+        available += 8;
+      }
+      uint32_t value = bits & MASK;
+      bits >>= BITS;
+      available -= BITS;
+      return value;
+    }
+
+  protected:
+    const uint8_t * buffer;
+    uint32_t bits = 0;
+    uint8_t available = 0;
+};
+
+// Packs 'count' channels, 'getValue(i)' returning the already scaled value of channel i
+template <uint8_t BITS, class F>
+inline void packChannels(uint8_t *& buffer, uint8_t count, F getValue)
+{
+  ChannelsPacker<BITS> packer(buffer);
+  for (uint8_t i = 0; i < count; i++) {
+    packer.push(getValue(i));
+  }
+}
@@ -25,10 +25,13 @@
 #include "hal/module_port.h"
 
 #include "crossfire.h"
+#include "channels_packer.h"
 #include "telemetry/crossfire.h"
 
 #define CROSSFIRE_CH_BITS           11
 #define CROSSFIRE_CENTER            0x3E0
+#define CROSSFIRE_SUBSET_RES_11BITS (1 << 5)
+#define CROSSFIRE_SUBSET_PERIOD     4
 #if defined(PPM_CENTER_ADJUSTABLE)
   #define CROSSFIRE_CENTER_CH_OFFSET(ch)            ((2 * limitAddress(ch)->ppmCenter) + 1)  // + 1 is for rouding
 #else
@@ -60,22 +63,63 @@ uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses)
   *buf++ = 24; // 1(ID) + 22 + 1(CRC)
   uint8_t * crc_start = buf;
   *buf++ = CHANNELS_ID;
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
-    uint32_t val = limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(i) * 4) / 5 + (pulses[i] * 4) / 5, 2 * CROSSFIRE_CENTER);
-    bits |= val << bitsavailable;
-    bitsavailable += CROSSFIRE_CH_BITS;
-    while (bitsavailable >= 8) {
-      *buf++ = bits;
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
-  }
+  packChannels<CROSSFIRE_CH_BITS>(buf, CROSSFIRE_CHANNELS_COUNT, [=](uint8_t i) -> uint32_t {
+    return limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(i) * 4) / 5 + (pulses[i] * 4) / 5, 2 * CROSSFIRE_CENTER);
+  });
   *buf++ = crc8(crc_start, 23);
   return buf - frame;
 }
 
+// Subset frames use their own scale: with 11 bits resolution, 0.5us per step
+// and 0 = 988us, so 1024 = 1500us and pulses map one to one
+static inline uint32_t crossfireSubsetChannelValue(int16_t * pulses, uint8_t ch)
+{
+  return limit(0, 1024 + pulses[ch] + 2 * (PPM_CH_CENTER(ch) - PPM_CENTER), 2047);
+}
+
+// Channels [start : start + count - 1] only
+uint8_t createCrossfireSubsetChannelsFrame(uint8_t * frame, int16_t * pulses, uint8_t start, uint8_t count)
+{
+  uint8_t * buf = frame;
+  *buf++ = MODULE_ADDRESS;
+  uint8_t * len = buf++;
+  uint8_t * crc_start = buf;
+  *buf++ = SUBSET_CHANNELS_ID;
+  *buf++ = start | CROSSFIRE_SUBSET_RES_11BITS;
+  packChannels<CROSSFIRE_CH_BITS>(buf, count, [=](uint8_t i) -> uint32_t {
+    return crossfireSubsetChannelValue(pulses, start + i);
+  });
+  *len = buf - crc_start + 1; // + 1(CRC)
+  *buf = crc8(crc_start, buf - crc_start);
+  return ++buf - frame;
+}
+
+// When subset frames are enabled in the model and the module uses less than
+// 16 channels, each frame only carries the used channels, and every
+// CROSSFIRE_SUBSET_PERIOD frames the used channels are replaced by the next
+// block of the remaining ones
+static struct {
+  uint8_t frame;
+  uint8_t next;
+} crossfireSubsets[NUM_MODULES];
+
+static uint8_t createCrossfireSubsetFrame(uint8_t module, uint8_t * frame, int16_t * pulses, uint8_t used)
+{
+  auto & subset = crossfireSubsets[module];
+  if (++subset.frame < CROSSFIRE_SUBSET_PERIOD) {
+    return createCrossfireSubsetChannelsFrame(frame, pulses, 0, used);
+  }
+
+  subset.frame = 0;
+  if (subset.next < used || subset.next >= CROSSFIRE_CHANNELS_COUNT) {
+    subset.next = used;
+  }
+  uint8_t start = subset.next;
+  uint8_t count = min<uint8_t>(used, CROSSFIRE_CHANNELS_COUNT - start);
+  subset.next += count;
+  return createCrossfireSubsetChannelsFrame(frame, pulses, start, count);
+}
+
 static void setupPulsesCrossfire(uint8_t module, uint8_t*& p_buf,
                                  uint8_t endpoint, int16_t* channels,
                                  uint8_t nChannels)
@@ -93,8 +137,11 @@ static void setupPulsesCrossfire(uint8_t module, uint8_t*& p_buf,
       p_buf += createCrossfireModelIDFrame(module, p_buf);
       moduleState[module].counter = CRSF_FRAME_MODELID_SENT;
     } else {
-      /* TODO: nChannels */
-      p_buf += createCrossfireChannelsFrame(p_buf, channels);
+      uint8_t used = min<uint8_t>(sentModuleChannels(module), nChannels);
+      if (g_model.moduleData[module].crsf.subsetChannels && used < CROSSFIRE_CHANNELS_COUNT)
+        p_buf += createCrossfireSubsetFrame(module, p_buf, channels, used);
+      else
+        p_buf += createCrossfireChannelsFrame(p_buf, channels);
     }
   }
 }
@@ -239,6 +286,7 @@ static void* crossfireInit(uint8_t module)
 #endif
 
   if (mod_st) {
+    memclear(&crossfireSubsets[module], sizeof(crossfireSubsets[module]));
     mixerSchedulerSetPeriod(module, CROSSFIRE_PERIOD(module));
   }
 
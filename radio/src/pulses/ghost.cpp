@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "ghost.h"
+#include "channels_packer.h"
 #include "telemetry/ghost.h"
 #include "telemetry/ghost_menu.h"
 #include "hal/module_port.h"
@@ -102,27 +103,22 @@ static uint8_t createGhostChannelsFrame(uint8_t * frame, int16_t * pulses, bool
 
   // payload
   // first 4 high speed, 12 bit channels (11 relevant bits with openTx)
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-  for (int i = 0; i < 4; i++) {
-    uint32_t value;
-    if (raw12bits) {
-    value = limit(
-        0, (1024 + (pulses[i] + 2 * PPM_CH_CENTER(i) - 2 * PPM_CENTER)) << 1,
-        0xFFF);
-    } else {
-    value = limit(
-        0,
-        GHST_RC_CTR_VAL_12BIT +
-            (((pulses[i] + 2 * PPM_CH_CENTER(i) - 2 * PPM_CENTER) << 3) / 5),
-        2 * GHST_RC_CTR_VAL_12BIT);
-    }
-    bits |= value << bitsavailable;
-    bitsavailable += GHST_CH_BITS_12;
-    while (bitsavailable >= 8) {
-      *buf++ = bits;
-      bits >>= 8;
-      bitsavailable -= 8;
+  {
+    ChannelsPacker<GHST_CH_BITS_12> packer(buf);
+    for (int i = 0; i < 4; i++) {
+      uint32_t value;
+      if (raw12bits) {
+        value = limit(
+            0, (1024 + (pulses[i] + 2 * PPM_CH_CENTER(i) - 2 * PPM_CENTER)) << 1,
+            0xFFF);
+      } else {
+        value = limit(
+            0,
+            GHST_RC_CTR_VAL_12BIT +
+                (((pulses[i] + 2 * PPM_CH_CENTER(i) - 2 * PPM_CENTER) << 3) / 5),
+            2 * GHST_RC_CTR_VAL_12BIT);
+      }
+      packer.push(value);
     }
   }
 
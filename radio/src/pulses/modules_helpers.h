@@ -42,6 +42,7 @@ extern uint32_t NV14internalModuleFwVersion;
 #endif
 
 #define CROSSFIRE_CHANNELS_COUNT        16
+#define CROSSFIRE_MIN_CHANNELS_COUNT    4
 #define GHOST_CHANNELS_COUNT            16
 
 #define IS_NATIVE_FRSKY_PROTOCOL(module)                                \
@@ -504,7 +505,7 @@ inline int8_t maxModuleChannels(uint8_t moduleIdx)
 inline int8_t minModuleChannels(uint8_t idx)
 {
   if (isModuleCrossfire(idx))
-    return CROSSFIRE_CHANNELS_COUNT;
+    return g_model.moduleData[idx].crsf.subsetChannels ? CROSSFIRE_MIN_CHANNELS_COUNT : CROSSFIRE_CHANNELS_COUNT;
   else if (isModuleGhost(idx))
     return GHOST_CHANNELS_COUNT;
   else if (isModuleSBUS(idx))
@@ -530,7 +531,7 @@ inline uint8_t sentModulePXXChannels(uint8_t idx)
 
 inline int8_t sentModuleChannels(uint8_t idx)
 {
-  if (isModuleCrossfire(idx))
+  if (isModuleCrossfire(idx) && !g_model.moduleData[idx].crsf.subsetChannels)
     return CROSSFIRE_CHANNELS_COUNT;
   else if (isModuleGhost(idx))
     return GHOST_CHANNELS_COUNT;
@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "multi.h"
+#include "channels_packer.h"
 
 #include "io/multi_protolist.h"
 #include "telemetry/multi.h"
@@ -81,8 +82,7 @@ static void updateMultiSync(uint8_t module)
 
 static void sendFailsafeChannels(uint8_t*& p_buf, uint8_t module)
 {
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
+  ChannelsPacker<MULTI_CHAN_BITS> packer(p_buf);
 
   for (int i = 0; i < MULTI_CHANS; i++) {
     int16_t failsafeValue = g_model.failsafeChannels[i];
@@ -102,13 +102,7 @@ static void sendFailsafeChannels(uint8_t*& p_buf, uint8_t module)
       pulseValue = limit(1, (failsafeValue * 800 / 1000) + 1024, 2046);
     }
 
-    bits |= pulseValue << bitsavailable;
-    bitsavailable += MULTI_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendMulti(p_buf, (uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    packer.push(pulseValue);
   }
 }
 
@@ -295,28 +289,17 @@ const etx_proto_driver_t MultiDriver = {
 
 static void sendChannels(uint8_t*& p_buf, uint8_t module)
 {
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-
   // byte 4-25, channels 0..2047
   // Range for pulses (channelsOutputs) is [-1024:+1024] for [-100%;100%]
   // Multi uses [204;1843] as [-100%;100%]
-  for (int i = 0; i < MULTI_CHANS; i++) {
+  packChannels<MULTI_CHAN_BITS>(p_buf, MULTI_CHANS, [=](uint8_t i) -> uint32_t {
     int channel = g_model.moduleData[module].channelsStart + i;
     int value = channelOutputs[channel] + 2 * PPM_CH_CENTER(channel) - 2 * PPM_CENTER;
 
     // Scale to 80%
     value = value * 800 / 1000 + 1024;
-    value = limit(0, value, 2047);
-
-    bits |= value << bitsavailable;
-    bitsavailable += MULTI_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendMulti(p_buf, (uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
-  }
+    return limit(0, value, 2047);
+  });
 }
 
 void sendFrameProtocolHeader(uint8_t*& p_buf, uint8_t module, bool failsafe)
@@ -44,41 +44,59 @@ bool Pxx2OtaUpdate::waitStep(uint8_t step, uint8_t timeout)
   return true;
 }
 
-const char* Pxx2OtaUpdate::nextStep(uint8_t step, const char* rxName,
-                                    uint32_t address, const uint8_t* buffer)
+void Pxx2OtaUpdate::sendFrame(const char* rxName, uint32_t address,
+                              const uint8_t* buffer)
+{
+  uint8_t* module_buffer = pulsesGetModuleBuffer(module);
+  Pxx2Pulses pxx2(module_buffer);
+  pxx2.sendOtaUpdate(module, rxName, address, (const char *) buffer);
+
+  // send the frame immediately
+  auto mod = pulsesGetModuleDriver(module);
+  auto mod_st = (etx_module_state_t*)mod->ctx;
+
+  auto drv = modulePortGetSerialDrv(mod_st->tx);
+  auto ctx = modulePortGetCtx(mod_st->tx);
+  drv->sendBuffer(ctx, module_buffer, pxx2.getSize());
+}
+
+void Pxx2OtaUpdate::startStep(uint8_t step, const char* rxName,
+                              uint32_t address, const uint8_t* buffer)
 {
   OtaUpdateInformation * destination = moduleState[module].otaUpdateInformation;
 
   destination->step = step;
   destination->address = address;
 
-  for (uint8_t retry = 0;; retry++) {
-    uint8_t* module_buffer = pulsesGetModuleBuffer(module);
-    Pxx2Pulses pxx2(module_buffer);
-    pxx2.sendOtaUpdate(module, rxName, address, (const char *) buffer);
-
-    // send the frame immediately
-    auto mod = pulsesGetModuleDriver(module);
-    auto mod_st = (etx_module_state_t*)mod->ctx;
-
-    auto drv = modulePortGetSerialDrv(mod_st->tx);
-    auto ctx = modulePortGetCtx(mod_st->tx);
-    drv->sendBuffer(ctx, module_buffer, pxx2.getSize());
+  sendFrame(rxName, address, buffer);
+}
 
+const char* Pxx2OtaUpdate::endStep(uint8_t step, const char* rxName,
+                                   uint32_t address, const uint8_t* buffer)
+{
+  for (uint8_t retry = 0;; retry++) {
     if (waitStep(step + 1, 20)) {
       return nullptr;
     }
     else if (retry == 100) {
       return "Transfer failed";
     }
+    sendFrame(rxName, address, buffer);
   }
 }
 
+const char* Pxx2OtaUpdate::nextStep(uint8_t step, const char* rxName,
+                                    uint32_t address, const uint8_t* buffer)
+{
+  startStep(step, rxName, address, buffer);
+  return endStep(step, rxName, address, buffer);
+}
+
 const char* Pxx2OtaUpdate::doFlashFirmware(const char* filename,
                                            ProgressHandler progressHandler)
 {
   FIL file;
-  uint8_t buffer[32];
+  uint8_t buffer[2][32];
   UINT count;
   const char * result;
 
@@ -106,25 +124,40 @@ const char* Pxx2OtaUpdate::doFlashFirmware(const char* filename,
     size = f_size(&file);
   }
 
+  uint8_t current = 0;
+  if (f_read(&file, buffer[current], sizeof(buffer[current]), &count) != FR_OK) {
+    f_close(&file);
+    return "Read file failed";
+  }
+
   uint32_t done = 0;
   while (1) {
     progressHandler(getBasename(filename), STR_OTA_UPDATE, done, size);
-    if (f_read(&file, buffer, sizeof(buffer), &count) != FR_OK) {
+
+    startStep(OTA_UPDATE_TRANSFER, nullptr, done, buffer[current]);
+
+    // read the next block while this one is being sent and acknowledged
+    UINT next = 0;
+    if (count == sizeof(buffer[current]) &&
+        f_read(&file, buffer[current ^ 1], sizeof(buffer[current]), &next) != FR_OK) {
       f_close(&file);
       return "Read file failed";
     }
 
-    result = nextStep(OTA_UPDATE_TRANSFER, nullptr, done, buffer);
+    result = endStep(OTA_UPDATE_TRANSFER, nullptr, done, buffer[current]);
     if (result) {
+      f_close(&file);
       return result;
     }
 
-    if (count < sizeof(buffer)) {
+    if (count < sizeof(buffer[current])) {
       f_close(&file);
       break;
     }
 
     done += count;
+    count = next;
+    current ^= 1;
   }
 
   return nextStep(OTA_UPDATE_EOF, nullptr, done, nullptr);
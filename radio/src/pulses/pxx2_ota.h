@@ -47,6 +47,11 @@ class Pxx2OtaUpdate {
 
     const char * doFlashFirmware(const char * filename, ProgressHandler progressHandler);
     bool waitStep(uint8_t step, uint8_t timeout);
+    void sendFrame(const char* rxName, uint32_t address, const uint8_t* buffer);
+    void startStep(uint8_t step, const char* rxName, uint32_t address,
+                   const uint8_t* buffer);
+    const char* endStep(uint8_t step, const char* rxName, uint32_t address,
+                        const uint8_t* buffer);
     const char* nextStep(uint8_t step, const char* rxName, uint32_t address,
                          const uint8_t* buffer);
 };
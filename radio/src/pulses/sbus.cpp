@@ -20,6 +20,7 @@
  */
 
 #include "sbus.h"
+#include "channels_packer.h"
 #include "hal/module_port.h"
 #include "mixer_scheduler.h"
 
@@ -59,22 +60,12 @@ static void setupPulsesSbus(uint8_t module, uint8_t*& p_buf)
   // Sync Byte
   sendByte(p_buf, SBUS_FRAME_BEGIN_BYTE);
 
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-
   // byte 1-22, channels 0..2047, limits not really clear (B
-  for (int i=0; i<SBUS_NORMAL_CHANS; i++) {
+  packChannels<SBUS_CHAN_BITS>(p_buf, SBUS_NORMAL_CHANS, [=](uint8_t i) -> uint32_t {
     int value = getChannelValue(module, i);
-
     value =  value*8/10 + SBUS_CHAN_CENTER;
-    bits |= limit(0, value, 2047) << bitsavailable;
-    bitsavailable += SBUS_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendByte(p_buf, (uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
-  }
+    return limit(0, value, 2047);
+  });
 
   // flags
   uint8_t flags=0;
@@ -22,6 +22,7 @@
 #include "opentx.h"
 #include "sbus.h"
 #include "timers_driver.h"
+#include "pulses/channels_packer.h"
 
 #define SBUS_FRAME_GAP_DELAY   1000 // 500uS
 
@@ -32,7 +33,6 @@
 #define SBUS_FAILSAFE_BIT      3
 
 #define SBUS_CH_BITS           11
-#define SBUS_CH_MASK           ((1<<SBUS_CH_BITS) - 1)
 
 #define SBUS_CH_CENTER         0x3E0
 
@@ -77,18 +77,9 @@ void processSbusFrame(uint8_t * sbus, int16_t * pulses, uint32_t size)
     return;  // SBUS invalid frame or failsafe mode
   }
 
-  sbus++; // skip start byte
-
-  uint32_t inputbitsavailable = 0;
-  uint32_t inputbits = 0;
+  ChannelsUnpacker<SBUS_CH_BITS> unpacker(sbus + 1); // skip start byte
   for (uint32_t i=0; i<MAX_TRAINER_CHANNELS; i++) {
-    while (inputbitsavailable < SBUS_CH_BITS) {
-      inputbits |= *sbus++ << inputbitsavailable;
-      inputbitsavailable += 8;
-    }
-    *pulses++ = ((int32_t) (inputbits & SBUS_CH_MASK) - SBUS_CH_CENTER) * 5 / 8;
-    inputbitsavailable -= SBUS_CH_BITS;
-    inputbits >>= SBUS_CH_BITS;
+    *pulses++ = ((int32_t) unpacker.pop() - SBUS_CH_CENTER) * 5 / 8;
   }
 
   ppmInputValidityTimer = PPM_IN_VALID_TIMEOUT;
@@ -334,43 +334,110 @@ bool sdListFiles(const char * path, const char * extension, const uint8_t maxlen
 #endif // !LIBOPENUI
 
 #if defined(SDCARD)
-const char * sdCopyFile(const char * srcPath, const char * destPath)
+#if defined(COLORLCD)
+  #define SD_COPY_BUFFER_SIZE  (32 * 1024)
+#else
+  #define SD_COPY_BUFFER_SIZE  (4 * 1024)
+#endif
+
+// The copy buffer is taken from the heap for the duration of the copy,
+// a smaller one is used if memory is short. Whole sectors are read and
+// written, so that FatFs transfers them directly from / to the buffer.
+static uint8_t * sdAllocCopyBuffer(UINT & size)
+{
+  for (size = SD_COPY_BUFFER_SIZE; size >= FF_MAX_SS; size /= 2) {
+    auto buf = (uint8_t *)malloc(size);
+    if (buf) {
+      return buf;
+    }
+  }
+  return nullptr;
+}
+
+static FRESULT sdCopyData(FIL * srcFile, FIL * destFile, uint8_t * buf, UINT size,
+                          SdCopyProgress progress, void * ctx, bool & cancelled)
+{
+  FSIZE_t total = f_size(srcFile);
+  FSIZE_t copied = 0;
+
+  // allocate all the clusters of the destination at once
+  FRESULT result = f_lseek(destFile, total);
+  if (result == FR_OK && f_tell(destFile) != total) {
+    result = FR_DENIED; // disk full
+  }
+  if (result == FR_OK) {
+    result = f_lseek(destFile, 0);
+  }
+
+  while (result == FR_OK && copied < total) {
+    UINT read, written;
+    result = f_read(srcFile, buf, size, &read);
+    if (result != FR_OK) {
+      break;
+    }
+    if (read == 0) {
+      // source truncated meanwhile
+      result = FR_INT_ERR;
+      break;
+    }
+    result = f_write(destFile, buf, read, &written);
+    if (result == FR_OK && written != read) {
+      result = FR_DENIED;
+    }
+    copied += read;
+    if (progress && !progress((uint32_t)copied, (uint32_t)total, ctx)) {
+      cancelled = true;
+      break;
+    }
+  }
+
+  return result;
+}
+
+const char * sdCopyFile(const char * srcPath, const char * destPath, SdCopyProgress progress, void * ctx)
 {
   FIL srcFile;
   FIL destFile;
-  char buf[256];
-  UINT read = sizeof(buf);
-  UINT written = sizeof(buf);
 
   FRESULT result = f_open(&srcFile, srcPath, FA_OPEN_EXISTING | FA_READ);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
+  UINT size;
+  uint8_t * buf = sdAllocCopyBuffer(size);
+  if (!buf) {
+    f_close(&srcFile);
+    return SDCARD_ERROR(FR_NOT_ENOUGH_CORE);
+  }
+
   result = f_open(&destFile, destPath, FA_CREATE_ALWAYS | FA_WRITE);
   if (result != FR_OK) {
+    free(buf);
     f_close(&srcFile);
     return SDCARD_ERROR(result);
   }
 
-  while (result==FR_OK && read==sizeof(buf) && written==sizeof(buf)) {
-    result = f_read(&srcFile, buf, sizeof(buf), &read);
-    if (result == FR_OK) {
-      result = f_write(&destFile, buf, read, &written);
-    }
-  }
+  bool cancelled = false;
+  result = sdCopyData(&srcFile, &destFile, buf, size, progress, ctx, cancelled);
+  free(buf);
 
-  f_close(&destFile);
+  FRESULT closeResult = f_close(&destFile);
+  if (result == FR_OK) {
+    result = closeResult;
+  }
   f_close(&srcFile);
 
-  if (result != FR_OK) {
-    return SDCARD_ERROR(result);
+  if (result != FR_OK || cancelled) {
+    // do not leave a partial copy behind
+    f_unlink(destPath);
+    return cancelled ? STR_CANCEL : SDCARD_ERROR(result);
   }
 
   return nullptr;
 }
 
-const char * sdCopyFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir)
+const char * sdCopyFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir, SdCopyProgress progress, void * ctx)
 {
   char srcPath[2*CLIPBOARD_PATH_LEN+1];
   char * tmp = strAppend(srcPath, srcDir, CLIPBOARD_PATH_LEN);
@@ -382,19 +449,35 @@ const char * sdCopyFile(const char * srcFilename, const char * srcDir, const cha
   *tmp++ = '/';
   strAppend(tmp, destFilename, CLIPBOARD_PATH_LEN);
 
-  return sdCopyFile(srcPath, destPath);
+  return sdCopyFile(srcPath, destPath, progress, ctx);
 }
 
 // Will overwrite if destination exists
 const char * sdMoveFile(const char * srcPath, const char * destPath)
 {
+  if (!strcasecmp(srcPath, destPath)) {
+    return nullptr;
+  }
+
+  // on the same volume, only the directory entry needs to be moved
+  FRESULT fres = f_rename(srcPath, destPath);
+  if (fres == FR_EXIST) {
+    fres = f_unlink(destPath);
+    if (fres == FR_OK) {
+      fres = f_rename(srcPath, destPath);
+    }
+  }
+  if (fres == FR_OK) {
+    return nullptr;
+  }
+
   const char *result;
   result = sdCopyFile(srcPath, destPath);
   if(result != 0) {
     return result;
   }
 
-  FRESULT fres = f_unlink(srcPath);
+  fres = f_unlink(srcPath);
   if(fres != FR_OK) {
     return SDCARD_ERROR(fres);
   }
@@ -404,21 +487,17 @@ const char * sdMoveFile(const char * srcPath, const char * destPath)
 // Will overwrite if destination exists
 const char * sdMoveFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir)
 {
-  const char *result;
-  result = sdCopyFile(srcFilename, srcDir, destFilename, destDir);
-  if(result != 0) {
-    return result;
-  }
-
   char srcPath[2*CLIPBOARD_PATH_LEN+1];
   char * tmp = strAppend(srcPath, srcDir, CLIPBOARD_PATH_LEN);
   *tmp++ = '/';
   strAppend(tmp, srcFilename, CLIPBOARD_PATH_LEN);
-  FRESULT fres = f_unlink(srcPath);
-  if(fres != FR_OK) {
-    return SDCARD_ERROR(fres);
-  }
-  return nullptr;
+
+  char destPath[2*CLIPBOARD_PATH_LEN+1];
+  tmp = strAppend(destPath, destDir, CLIPBOARD_PATH_LEN);
+  *tmp++ = '/';
+  strAppend(tmp, destFilename, CLIPBOARD_PATH_LEN);
+
+  return sdMoveFile(srcPath, destPath);
 }
 
 #endif // defined(SDCARD)
@@ -85,6 +85,7 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
 #define LOGS_EXT            ".csv"
 #define SOUNDS_EXT          ".wav"
 #define BMP_EXT             ".bmp"
+#define SCREENREC_EXT       ".rec"
 #define PNG_EXT             ".png"
 #define JPG_EXT             ".jpg"
 #define SCRIPT_EXT          ".lua"
@@ -145,8 +146,11 @@ const char * getBasename(const char * path);
 bool isFileAvailable(const char * filename, bool exclDir = false);
 unsigned int findNextFileIndex(char * filename, uint8_t size, const char * directory);
 
-const char * sdCopyFile(const char * src, const char * dest);
-const char * sdCopyFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir);
+// Called after each block copied, returns false to cancel the copy
+typedef bool (*SdCopyProgress)(uint32_t copied, uint32_t total, void * ctx);
+
+const char * sdCopyFile(const char * src, const char * dest, SdCopyProgress progress = nullptr, void * ctx = nullptr);
+const char * sdCopyFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir, SdCopyProgress progress = nullptr, void * ctx = nullptr);
 const char * sdMoveFile(const char * src, const char * dest);
 const char * sdMoveFile(const char * srcFilename, const char * srcDir, const char * destFilename, const char * destDir);
 
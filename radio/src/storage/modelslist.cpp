@@ -52,9 +52,80 @@ using std::list;
 #define TRACE_LABELS(...)
 #endif
 
+// Delay between two model files updated with pending labels
+#define PENDING_LABELS_DELAY_10MS 100
+
 ModelsList modelslist;
 ModelMap modelslabels;
 
+/**
+ * @brief Fixed size blocks of ModelCell, with a list of the free cells
+ *
+ * Blocks are never released: reloading the models list reuses the same
+ * cells instead of fragmenting the heap with hundreds of small allocations
+ */
+
+class ModelCellPool
+{
+ public:
+  void *allocate()
+  {
+    if (!freeSlots && !addBlock()) return nullptr;
+    Slot *slot = freeSlots;
+    freeSlots = slot->next;
+    return slot;
+  }
+
+  void release(void *ptr)
+  {
+    Slot *slot = static_cast<Slot *>(ptr);
+    slot->next = freeSlots;
+    freeSlots = slot;
+  }
+
+ protected:
+  static constexpr unsigned CELLS_PER_BLOCK = 16;
+
+  union Slot {
+    Slot *next;
+    alignas(ModelCell) uint8_t cell[sizeof(ModelCell)];
+  };
+
+  struct Block {
+    Block *next;
+    Slot slots[CELLS_PER_BLOCK];
+  };
+
+  Block *blocks = nullptr;
+  Slot *freeSlots = nullptr;
+
+  bool addBlock()
+  {
+    Block *block = (Block *)malloc(sizeof(Block));
+    if (!block) return false;
+    block->next = blocks;
+    blocks = block;
+    // cells are then allocated in order
+    for (int i = CELLS_PER_BLOCK - 1; i >= 0; i--) {
+      release(&block->slots[i]);
+    }
+    return true;
+  }
+};
+
+static ModelCellPool modelCellPool;
+
+void *ModelCell::operator new(size_t size) noexcept
+{
+  UNUSED(size);
+  return modelCellPool.allocate();
+}
+
+void ModelCell::operator delete(void *ptr)
+{
+  if (ptr) modelCellPool.release(ptr);
+}
+
 ModelCell::ModelCell(const char *fileName) : valid_rfData(false)
 {
   strncpy(modelFilename, fileName, sizeof(modelFilename) - 1);
@@ -125,125 +196,70 @@ void ModelCell::setRfModuleData(uint8_t moduleIdx, ModuleData *modData)
 }
 
 //-----------------------------------------------------------------------------
+
 /**
- * @brief Gets all models which don't have any labels selected
- *
- * @param sortby
- * @return ModelsVector vector<ModelCell>
+ * @brief Returns true if at least one model has no label, without building
+ *        (and sorting) the list
  */
 
-ModelsVector ModelMap::getUnlabeledModels()
+bool ModelMap::hasUnlabeledModels()
 {
-  ModelsVector unlabeledModels;
   for (auto model : modelslist) {
-    if (modelslabels.getLabelsByModel(model).size() == 0)
-      unlabeledModels.emplace_back(model);
+    if (model->labelsMask.none()) return true;
   }
-  sortModelsBy(unlabeledModels, _sortOrder);
-  return unlabeledModels;
-}
-
-/**
- * @brief Returns a sorted list of all models
- */
-
-ModelsVector ModelMap::getAllModels()
-{
-  ModelsVector all = modelslist;
-  sortModelsBy(all, _sortOrder);
-  return all;
+  return false;
 }
 
 /**
- * @brief Returns all models that have a sepecified label
- *
- * @param lbl Label to search
- * @return ModelsVector aka vector<ModelCell*> of all models belonging to a
- * label
+ * @brief Returns true if at least one model has the label, without building
+ *        (and sorting) the list
  */
 
-ModelsVector ModelMap::getModelsByLabel(const std::string &lbl)
+bool ModelMap::hasModelsInLabel(const std::string &lbl)
 {
   int index = getIndexByLabel(lbl);
-  if (index < 0) return ModelsVector();
-  ModelsVector rv;
-  for (auto it = begin(); it != end(); ++it) {
-    if (it->first == index) rv.push_back(it->second);
+  if (index < 0) return false;
+  for (auto model : modelslist) {
+    if (model->labelsMask.test(index)) return true;
   }
-  sortModelsBy(rv, _sortOrder);
-  return rv;
+  return false;
 }
 
 /**
- * @brief Returns all models that are in multiple labels (OR function)
+ * @brief Calls a function for each model that is in all the labels (AND
+ *        function), in the sort order, without building a list
+ * @details Only the unlabeled models are visited if the unlabeled label is
+ *          the only one, all the models if no label is given. The sorted view
+ *          is kept from one call to the next, so that no memory is allocated
+ *          once it has grown to the number of models.
  *
  * @param lbls Labels to search
- * @return ModelsVector aka vector<ModelCell*> of all models belonging to a
- * label
+ * @param fn Function called with each model
  */
 
-ModelsVector ModelMap::getModelsByLabels(const LabelsVector &lbls)
+void ModelMap::forEachModelInLabels(const LabelsVector &lbls,
+                                    const std::function<void(ModelCell *)> &fn)
 {
-  bool addunlabeled = false;
-  // Build a list of the requested indexes
-  std::vector<int> idxvect;
+  // Requesting only Unlabeled models
+  bool unlabeled = lbls.size() == 1 && lbls.at(0) == STR_UNLABELEDMODEL;
+
+  // Build a mask of the requested indexes
+  LabelsMask wanted;
   for (const auto &lbl : lbls) {
-    if (lbl == STR_UNLABELEDMODEL) addunlabeled = true;
+    if (lbl == STR_UNLABELEDMODEL)  // If requesting unlabeled model ignore it
+      continue;
     int index = getIndexByLabel(lbl);
-    if (index >= 0) idxvect.push_back(index);
+    if (index < 0) return;  // No model can have it
+    wanted.set(index);
   }
 
-  ModelsVector rv;
-  for (auto it = begin(); it != end(); ++it) {
-    for (auto idx : idxvect) {
-      if (it->first == idx) rv.push_back(it->second);
-    }
-  }
+  sortedModels.assign(modelslist.begin(), modelslist.end());
+  sortModelsBy(sortedModels, _sortOrder);
 
-  if (addunlabeled) {
-    ModelsVector unlabeled = getUnlabeledModels();
-    rv.insert(rv.end(), unlabeled.begin(), unlabeled.end());
+  for (auto model : sortedModels) {
+    const LabelsMask &mask = model->labelsMask;
+    if (unlabeled ? mask.none() : (mask & wanted) == wanted) fn(model);
   }
-
-  sortModelsBy(rv, _sortOrder);
-  return rv;
-}
-
-/**
- * @brief Returns all models that are in multiple labels (AND function)
- *
- * @param lbls Labels to search
- * @return ModelsVector aka vector<ModelCell*> of all models belonging to a
- * label
- */
-
-ModelsVector ModelMap::getModelsInLabels(const LabelsVector &lbls)
-{
-  if (lbls.size() == 0) return ModelsVector();
-
-  // Requesting only Unlabeled models
-  if (lbls.size() == 1 && lbls.at(0) == STR_UNLABELEDMODEL)
-    return getUnlabeledModels();
-
-  ModelsVector rv;
-
-  for (const auto &mdl : modelslist) {
-    bool hasAllLabels = true;
-    LabelsVector mdllables = getLabelsByModel(mdl);
-    for (const auto &lbl : lbls) {
-      if (lbl == STR_UNLABELEDMODEL)  // If requesting unlabeled model ignore it
-        break;
-      if (std::find(mdllables.begin(), mdllables.end(), lbl) ==
-          mdllables.end()) {
-        hasAllLabels = false;
-        break;
-      }
-    }
-    if (hasAllLabels) rv.push_back(mdl);
-  }
-
-  sortModelsBy(rv, _sortOrder);
-  return rv;
 }
 
 /**
@@ -257,10 +273,8 @@ LabelsVector ModelMap::getLabelsByModel(ModelCell *mdl)
 {
   if (mdl == nullptr) return LabelsVector();
   LabelsVector rv;
-  for (auto it = begin(); it != end(); ++it) {
-    if (it->second == mdl) {
-      rv.push_back(getLabelByIndex(it->first));
-    }
+  for (unsigned i = 0; i < labels.size(); i++) {
+    if (mdl->labelsMask.test(i)) rv.push_back(labels[i]);
   }
   return rv;
 }
@@ -299,11 +313,8 @@ std::map<std::string, bool> ModelMap::getSelectedLabels(ModelCell *cell)
 
 bool ModelMap::isLabelSelected(const std::string &label, ModelCell *cell)
 {
-  auto lbm = getLabelsByModel(cell);
-  if (std::find(lbm.begin(), lbm.end(), label) == lbm.end()) {
-    return false;
-  }
-  return true;
+  int index = getIndexByLabel(label);
+  return index >= 0 && cell && cell->labelsMask.test(index);
 }
 
 /**
@@ -346,6 +357,10 @@ int ModelMap::addLabel(std::string lbl)
   // Returns the index to the label
   int ind = getIndexByLabel(lbl);
   if (ind < 0) {
+    if (labels.size() >= MAX_LABELS) {
+      TRACE("Cannot add the %s label. Too many labels", lbl.c_str());
+      return -1;
+    }
     labels.push_back(lbl);
     setDirty();
     TRACE_LABELS("Added a label %s", lbl.c_str());
@@ -377,7 +392,7 @@ bool ModelMap::addLabelToModel(const std::string &lbl, ModelCell *cell,
 
   setDirty();
   int labelindex = addLabel(lbl);
-  insert(std::pair<int, ModelCell *>(labelindex, cell));
+  if (labelindex >= 0) cell->labelsMask.set(labelindex);
 
   if (update) updateModelFile(cell);  // Write labels into model
 
@@ -513,10 +528,8 @@ bool ModelMap::removeLabelFromModel(const std::string &label, ModelCell *cell,
   int lblind = getIndexByLabel(label);
   if (lblind < 0) return true;
   bool rv = true;
-  // Erase items that match in the map
-  for (ModelMap::const_iterator itr = cbegin(); itr != cend();) {
-    itr = (itr->first == lblind && itr->second == cell) ? erase(itr)
-                                                        : std::next(itr);
+  if (cell->labelsMask.test(lblind)) {
+    cell->labelsMask.reset(lblind);
     setDirty();
     rv = false;
   }
@@ -544,7 +557,7 @@ bool ModelMap::removeLabel(
   bool renameFault=true;
   renameLabel(label, "", std::move(progress));
   for (auto &lbl : labels) {
-    if (lbl == label && getModelsByLabel(lbl).size() == 0) {
+    if (lbl == label && !hasModelsInLabel(lbl)) {
       lbl = "";
       setDirty();
       renameFault = false;
@@ -582,20 +595,14 @@ bool ModelMap::moveLabelTo(unsigned curind, unsigned newind)
 
   std::swap(labels[curind], labels[newind]);
 
-  ModelMap newmap;
-  newmap.labels = labels;
-
-  for (auto &mm : modelslabels) {
-    uint16_t ind = mm.first;
-    if (ind == curind)
-      ind = newind;
-    else if (ind == newind)
-      ind = curind;
-    newmap.insert(std::make_pair(ind, mm.second));
+  for (auto cell : modelslist) {
+    LabelsMask &mask = cell->labelsMask;
+    if (mask.test(curind) != mask.test(newind)) {
+      mask.flip(curind);
+      mask.flip(newind);
+    }
   }
 
-  modelslabels = newmap;
-
   modelslist.save(labels);
   setDirty();
 
@@ -604,14 +611,15 @@ bool ModelMap::moveLabelTo(unsigned curind, unsigned newind)
 
 /**
  * @brief Rename a label
- * @details Opens all models which have a label that matches the <from> string.
- *          Renames the label with <to> string and saves file.
+ * @details Renames the label in labels.yml. Models which have a label that
+ *          matches the <from> string are only marked, their files are updated
+ *          afterwards one by one (see ModelsList::checkPendingLabels)
  *          If working on the current model it replaces the label string in
  *            g_model
  *
  * @param from Label to search
  * @param to Replacement label
- * @return true failure Label couldn't be found, YAML couldn't be read
+ * @return true failure Label couldn't be found, labels would be too long
  * @return false success
  */
 
@@ -630,23 +638,17 @@ bool ModelMap::renameLabel(const std::string &from, std::string to,
     }
   }
 
-  ModelData *modeldata = (ModelData *)malloc(sizeof(ModelData));
-  if (!modeldata) {
-    TRACE("Labels: Out Of Memory");
+  int fromind = getIndexByLabel(from);
+  if (fromind < 0) {
     if (progress != nullptr) progress("", 100); // Kill progress dialog
     return true;
   }
 
-  // Force a write of any changes in memory
-  storageCheck(true);
-
-  bool fault = false;
-  ModelsVector mods = getModelsByLabel(from);  // Find all models to be renamed
-
-  // Scan all these models first, recombine their labels to a csv,
+  // Scan all the models to be renamed first, recombine their labels to a csv,
   // make sure re-size is going to fit before starting. Otherwise new partial
   // labels would be created on next scan.
-  for(const auto &model: mods) {
+  for(const auto &model: modelslist) {
+    if (!model->labelsMask.test(fromind)) continue;
     int curlen = toCSV(getLabelsByModel(model)).size();
     std::string csvto = to;
     escapeCSV(csvto);
@@ -659,74 +661,45 @@ bool ModelMap::renameLabel(const std::string &from, std::string to,
     }
   }
 
-  int i = 0;
-  for (const auto &modcell : mods) {
-    if (progress != nullptr) {
-      progress(modcell->modelFilename, (i++) * 100 / mods.size());
-    }
-
-    readModelYaml(modcell->modelFilename, (uint8_t *)modeldata,
-                  sizeof(ModelData));
-
-    // Separate Curent CSV
-    LabelsVector lbls = ModelMap::fromCSV(modeldata->header.labels);
-
-    // Replace from->to strings
-    for (auto &lbl : lbls) {
-      if (lbl == from) lbl = to;
-    }
-
-    // Remove possible duplicates
-    std::sort(lbls.begin(), lbls.end());
-    auto last = std::unique(lbls.begin(), lbls.end());
-    lbls.erase(last, lbls.end());
-    lbls.resize(std::distance(lbls.begin(), last));
-
-    // Write back
-    strncpy(modeldata->header.labels, ModelMap::toCSV(lbls).c_str(), LABELS_LENGTH);
-    modeldata->header.labels[LABELS_LENGTH-1] = '\0';
-
-    char path[256];
-    getModelPath(path, modcell->modelFilename);
-
-    if (modcell == modelslist.getCurrentModel()) {
-      // If working on the current model, write current data to file instead
-      memcpy(g_model.header.labels, modeldata->header.labels, LABELS_LENGTH);
-      fault = (writeFileYaml(path, get_modeldata_nodes(),
-                             (uint8_t *)&g_model, 0) != NULL);
-    } else {
-      fault = (writeFileYaml(path, get_modeldata_nodes(),
-                             (uint8_t *)modeldata, 0) != NULL);
-    }
-#if defined(SIMU)
-    if (SIMU_SLEEP_OR_EXIT_MS(100)) break;
-#endif
+  int toind = to.size() > 0 ? getIndexByLabel(to) : -1;
+  bool moveModels = to.size() == 0 || toind >= 0;
+  if (toind >= 0) {
+    labels[fromind] = "";
+  } else if (!moveModels) {
+    labels[fromind] = to;
   }
 
-  // Rename the label
-  for (auto &lbl : labels) {
-    if (lbl == from) {
-      lbl = to;
-      setDirty(true);
+  int renamed = 0;
+  for (auto cell : modelslist) {
+    if (!cell->labelsMask.test(fromind)) continue;
+    if (moveModels) {
+      // Deleting, or merging into an existing label
+      cell->labelsMask.reset(fromind);
+      if (toind >= 0) cell->labelsMask.set(toind);
     }
+    updateModelFile(cell);
+    renamed++;
   }
 
   // Make sure to leave at 100, to kill rename dialog
   if (progress != nullptr) progress("", 100);
 
-  free(modeldata);
+  setDirty(true);
 
-  // Issue a rescan all of all models.
-  modelslist.clear();
-  modelslist.load();
+  // Rescan to drop the emptied label. Only labels.yml is read again, as
+  // the model files didn't change.
+  if (toind >= 0) {
+    modelslist.clear();
+    modelslist.load();
+  }
 
 #if defined(DEBUG_TIMERS)
   DEBUG_TIMER_SAMPLE(debugTimerYamlScan);
-  TRACE("Labels: Time to rename %d labels %luus", mods.size(),
+  TRACE("Labels: Time to rename %d labels %luus", renamed,
         debugTimers[debugTimerYamlScan].getLast());
 #endif
 
-  return fault;
+  return false;
 }
 
 /**
@@ -754,33 +727,26 @@ std::string ModelMap::getBulletLabelString(ModelCell *curmod, const char *noresu
 }
 
 /**
- * @brief Removes all models from the map
+ * @brief Removes a model from all its labels
  *
  * @param cell Model to remove
- * @return true Failure finding a model
+ * @return true The model had no label
  * @return false Success
  */
 
 bool ModelMap::removeModels(ModelCell *cell)
 {
-  bool rv = true;
-  // Erase items that match in the map
-  for (ModelMap::const_iterator itr = cbegin(); itr != cend();) {
-    if (itr->second == cell) {
-      itr = erase(itr);
-      setDirty();
-      rv = false;
-    } else {
-      itr = std::next(itr);
-    }
-  }
+  bool rv = cell->labelsMask.none();
+  cell->labelsMask.reset();
+  if (!rv) setDirty();
   return rv;
 }
 
 /**
- * @brief Opens a model.yml File and writes labels data into it.
+ * @brief Updates the labels of a model file
  * @details If the cell is current model then write the labels data to g_model
- * and mark as dirty
+ * and mark as dirty. Otherwise labels.yml is updated first, as it is used
+ * as long as the model file is unchanged, and the model file later on.
  *
  * @param cell
  * @return true
@@ -798,33 +764,9 @@ bool ModelMap::updateModelFile(ModelCell *cell)
     return false;
   }
 
-  ModelData *modeldata = (ModelData *)malloc(sizeof(ModelData));
-  if (!modeldata) {
-    TRACE("Labels: Out Of Memory");
-    return true;
-  }
-
-  bool fault = false;
-  readModelYaml(cell->modelFilename, (uint8_t *)modeldata, sizeof(ModelData));
-
-  strncpy(modeldata->header.labels, ModelMap::toCSV(getLabelsByModel(cell)).c_str(),
-          LABELS_LENGTH - 1);
-  modeldata->header.labels[LABELS_LENGTH - 1] = '\0';
-
-  char path[256];
-  getModelPath(path, cell->modelFilename);
-  fault = (writeFileYaml(path, get_modeldata_nodes(), (uint8_t *)modeldata, 0) !=
-           NULL);
-
-  free(modeldata);
-
-#if defined(DEBUG_TIMERS)
-  DEBUG_TIMER_SAMPLE(debugTimerYamlScan);
-  TRACE("Labels: Time to add/remove labels %luus",
-        debugTimers[debugTimerYamlScan].getLast());
-#endif
-
-  return fault;
+  cell->_labelsPending = true;
+  setDirty();
+  return false;
 }
 
 /**
@@ -878,6 +820,7 @@ void ModelsList::init()
 {
   loaded = false;
   currentModel = nullptr;
+  pendingLabelsTime = 0;
 }
 
 void ModelsList::clear()
@@ -911,6 +854,10 @@ bool ModelsList::loadTxt()
         line[len - 1] = '\0';
       } else if (len > 0) {
         model = new ModelCell(line);
+        if (!model) {
+          TRACE("ModelsList: no memory left for %s", line);
+          break;
+        }
         push_back(model);
         if (!strncmp(line, g_eeGeneral.currModelFilename, LEN_MODEL_FILENAME)) {
           currentModel = model;
@@ -979,6 +926,87 @@ char *FILInfoToHexStr(char buffer[17], FILINFO *finfo)
   return buffer;
 }
 
+/**
+ * @brief Writes the labels from labels.yml into the model file, if they
+ *        haven't been yet
+ *
+ * @param cell Model to update
+ * @return true Failure
+ * @return false Success, or nothing to do
+ */
+
+bool ModelsList::writeModelLabels(ModelCell *cell)
+{
+  if (!cell->_labelsPending) return false;
+
+  if (cell == currentModel) {
+    cell->_labelsPending = false;
+    return modelslabels.updateModelFile(cell);
+  }
+
+  ModelData *modeldata = (ModelData *)malloc(sizeof(ModelData));
+  if (!modeldata) {
+    TRACE("Labels: Out Of Memory");
+    return true;
+  }
+
+  DEBUG_TIMER_START(debugTimerYamlScan);
+
+  // Never write back a model which couldn't be read
+  bool fault = (readModelYaml(cell->modelFilename, (uint8_t *)modeldata,
+                              sizeof(ModelData)) != NULL);
+  if (!fault) {
+    strncpy(modeldata->header.labels,
+            ModelMap::toCSV(modelslabels.getLabelsByModel(cell)).c_str(),
+            LABELS_LENGTH - 1);
+    modeldata->header.labels[LABELS_LENGTH - 1] = '\0';
+    fault = (writeModelYaml(cell->modelFilename, (uint8_t *)modeldata) != NULL);
+  }
+
+  free(modeldata);
+
+  // Keep labels.yml in sync with the new file, so that it isn't read again
+  char path[256];
+  getModelPath(path, cell->modelFilename);
+  FILINFO finfo;
+  if (!fault && f_stat(path, &finfo) == FR_OK) {
+    FILInfoToHexStr(cell->modelFinfoHash, &finfo);
+  }
+  cell->_labelsPending = false;
+
+#if defined(DEBUG_TIMERS)
+  DEBUG_TIMER_SAMPLE(debugTimerYamlScan);
+  TRACE("Labels: Time to write labels into %s %luus", cell->modelFilename,
+        debugTimers[debugTimerYamlScan].getLast());
+#endif
+
+  return fault;
+}
+
+/**
+ * @brief Writes the pending labels into the model files, one model at a time
+ * @details Called periodically while nothing else needs to be saved.
+ *          labels.yml is only saved once all model files are up to date.
+ */
+
+void ModelsList::checkPendingLabels()
+{
+  if ((tmr10ms_t)(get_tmr10ms() - pendingLabelsTime) < PENDING_LABELS_DELAY_10MS)
+    return;
+  pendingLabelsTime = get_tmr10ms();
+
+  auto isPending = [](ModelCell *cell) { return cell->_labelsPending; };
+  auto it = std::find_if(begin(), end(), isPending);
+  if (it == end()) return;
+
+  if (writeModelLabels(*it)) {
+    TRACE("Labels: Unable to write labels into %s", (*it)->modelFilename);
+  }
+
+  // Save the new file hashes once done
+  if (std::none_of(begin(), end(), isPending)) modelslabels.setDirty();
+}
+
 /**
  * @brief Loads the Labels and Models from the labels.yml file
  *
@@ -1154,6 +1182,10 @@ bool ModelsList::loadYaml()
       TRACE_LABELS("  Created a modelcell for %s, not in labels.yml",
                    filehash.name.c_str());
       model = new ModelCell(filehash.name.c_str());
+      if (!model) {
+        TRACE("Labels: no memory left for %s", filehash.name.c_str());
+        break;
+      }
       strncpy(model->modelFinfoHash, filehash.hash, FILE_HASH_LENGTH);
       model->modelFinfoHash[FILE_HASH_LENGTH] = '\0';
       modelslist.push_back(model);
@@ -1233,8 +1265,10 @@ bool ModelsList::load(Format fmt)
       TRACE("  - No Models Found, making a new one");
       // No models found, make a new one
       auto model = modelslist.addModel(createModel(), true);
-      modelslist.setCurrentModel(model);
-      updateCurrentModelCell();
+      if (model) {
+        modelslist.setCurrentModel(model);
+        updateCurrentModelCell();
+      }
     }
   }
 
@@ -1250,6 +1284,47 @@ bool ModelsList::load(Format fmt)
  * @return const char* Error String on failure
  */
 
+// labels.yml is written through a sector sized buffer: with hundreds of
+// models, one f_puts() per attribute costs more than the SD writes themselves
+class LabelsFileWriter
+{
+ public:
+  explicit LabelsFileWriter(FIL *file) : file(file) {}
+
+  void put(const char *str) { write(str, strlen(str)); }
+  void put(const std::string &str) { write(str.data(), str.size()); }
+  void put(unsigned int value) { put(std::to_string(value)); }
+
+  FRESULT flush()
+  {
+    UINT written;
+    if (count > 0 && result == FR_OK) {
+      result = f_write(file, buffer, count, &written);
+      if (result == FR_OK && written != count) result = FR_DENIED;
+    }
+    count = 0;
+    return result;
+  }
+
+ protected:
+  FIL *file;
+  FRESULT result = FR_OK;
+  UINT count = 0;
+  char buffer[512];
+
+  void write(const char *str, size_t len)
+  {
+    while (len > 0) {
+      size_t n = std::min<size_t>(len, sizeof(buffer) - count);
+      memcpy(buffer + count, str, n);
+      count += n;
+      str += n;
+      len -= n;
+      if (count == sizeof(buffer)) flush();
+    }
+  }
+};
+
 const char *ModelsList::save(LabelsVector newOrder)
 {
 #if !defined(SDCARD_YAML)
@@ -1261,61 +1336,85 @@ const char *ModelsList::save(LabelsVector newOrder)
 #endif
   if (result != FR_OK) return "Couldn't open labels.yml for writing";
 
+  LabelsFileWriter out(&file);
+
   // Save current selection
-  f_puts("Labels:\r\n", &file);
+  out.put("Labels:\r\n");
 
   std::string cursel = modelslabels.getCurrentLabel();
   if(newOrder.empty())
     newOrder = modelslabels.getLabels();
   for (auto &lbl : newOrder) {
-    f_printf(&file, "  \"%s\":\r\n", lbl.c_str());
+    out.put("  \"");
+    out.put(lbl);
+    out.put("\":\r\n");
     if (modelslabels.isLabelFiltered(lbl))
-      f_printf(&file, "    selected: true\r\n", lbl.c_str());
+      out.put("    selected: true\r\n");
   }
 
   // Save current sort order
-  f_printf( &file, "Sort: %d\r\n", modelslabels.sortOrder());
+  out.put("Sort: ");
+  out.put(modelslabels.sortOrder());
+  out.put("\r\n");
 
-  f_puts("Models:\r\n", &file);
+  out.put("Models:\r\n");
   for (auto &model : modelslist) {
-    f_puts("  ", &file);
-    f_puts(model->modelFilename, &file);
-    f_puts(":\r\n", &file);
+    out.put("  ");
+    out.put(model->modelFilename);
+    out.put(":\r\n");
 
-    f_puts("    hash: \"", &file);
-    f_puts(model->modelFinfoHash, &file);
-    f_puts("\"\r\n", &file);
+    out.put("    hash: \"");
+    out.put(model->modelFinfoHash);
+    out.put("\"\r\n");
 
-    f_puts("    name: \"", &file);
-    f_puts(model->modelName, &file);
-    f_puts("\"\r\n", &file);
+    out.put("    name: \"");
+    out.put(model->modelName);
+    out.put("\"\r\n");
 
     for (int i = 0; i < NUM_MODULES; i++) {
-      if (model->modelId[i])
-        f_printf(&file, "    " MODULE_ID_STR ": %u\r\n", i,
-                 (unsigned int)model->modelId[i]);
-      if (model->moduleData[i].type)
-        f_printf(&file, "    " MODULE_TYPE_STR ": %u\r\n", i,
-                 (unsigned int)model->moduleData[i].type);
-      if (model->moduleData[i].subType)
-        f_printf(&file, "    " MODULE_RFPROTOCOL_STR ": %u\r\n", i,
-                 (unsigned int)model->moduleData[i].subType);
+      char attr[16];
+      if (model->modelId[i]) {
+        snprintf(attr, sizeof(attr), "    " MODULE_ID_STR ": ", i);
+        out.put(attr);
+        out.put(model->modelId[i]);
+        out.put("\r\n");
+      }
+      if (model->moduleData[i].type) {
+        snprintf(attr, sizeof(attr), "    " MODULE_TYPE_STR ": ", i);
+        out.put(attr);
+        out.put(model->moduleData[i].type);
+        out.put("\r\n");
+      }
+      if (model->moduleData[i].subType) {
+        snprintf(attr, sizeof(attr), "    " MODULE_RFPROTOCOL_STR ": ", i);
+        out.put(attr);
+        out.put(model->moduleData[i].subType);
+        out.put("\r\n");
+      }
     }
 
-    f_printf(&file, "    labels: \"%s\"\r\n", ModelMap::toCSV(modelslabels.getLabelsByModel(model)).c_str());
+    out.put("    labels: \"");
+    out.put(ModelMap::toCSV(modelslabels.getLabelsByModel(model)));
+    out.put("\"\r\n");
+
+    if (model->_labelsPending)
+      out.put("    pending: 1\r\n");
 
 #if LEN_BITMAP_NAME > 0
-    f_puts("    bitmap: \"", &file);
-    f_puts(model->modelBitmap, &file);
-    f_puts("\"\r\n", &file);
+    out.put("    bitmap: \"");
+    out.put(model->modelBitmap);
+    out.put("\"\r\n");
 #endif
-    f_puts("    lastopen: ", &file);
-    f_puts(std::to_string(model->lastOpened).c_str(), &file);
-    f_puts("\r\n", &file);
+    out.put("    lastopen: ");
+    out.put(std::to_string(model->lastOpened));
+    out.put("\r\n");
   }
 
-  f_puts("\r\n", &file);
+  out.put("\r\n");
+  result = out.flush();
   f_close(&file);
+  if (result != FR_OK) return "Couldn't write labels.yml";
+
   modelslabels._isDirty = false;
 
   return NULL;
@@ -1394,12 +1493,14 @@ bool ModelsList::readNextLine(char *line, int maxlen)
  * @param name Model File Name
  * @param save True=Update labels.yml right away
  * @param copyCell If duplicating copy the data from this cell, otherwise leave null
- * @return ModelCell* New Model
+ * @return ModelCell* New Model, nullptr if there is no memory left
  */
 
 ModelCell *ModelsList::addModel(const char *fileName, bool save, ModelCell *copyCell)
 {
   ModelCell *result = new ModelCell(fileName);
+  if (!result) return nullptr;
+
   if (copyCell != nullptr) { // Duplicate all data
     memcpy(result, copyCell, sizeof(ModelCell));
   }
@@ -25,6 +25,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <bitset>
 #include <functional>
 #include <list>
 #include <map>
@@ -70,6 +71,11 @@ typedef struct PACKED {
 
 #define FILE_HASH_LENGTH (sizeof(FInfoH) * 2)  // Hex string output
 
+// Labels are referenced by their index in labels.yml: each model has one bit
+// per label
+#define MAX_LABELS 64
+typedef std::bitset<MAX_LABELS> LabelsMask;
+
 class ModelCell
 {
  public:
@@ -81,6 +87,8 @@ class ModelCell
 #endif
   gtime_t lastOpened = 0;
   bool _isDirty = true;
+  bool _labelsPending = false;  // labels.yml is ahead of the model file
+  LabelsMask labelsMask;        // see ModelMap
 
   bool valid_rfData;
   uint8_t modelId[NUM_MODULES] = {0, 0};
@@ -89,6 +97,10 @@ class ModelCell
   explicit ModelCell(const char *fileName);
   explicit ModelCell(const char *fileName, uint8_t len);
 
+  // cells are allocated from a pool, see ModelCellPool
+  static void *operator new(size_t size) noexcept;
+  static void operator delete(void *ptr);
+
   void setModelName(char *name);
   void setModelName(char *name, uint8_t len);
   void setRfData(ModelData *model);
@@ -116,18 +128,19 @@ typedef enum {
 } ModelsSortBy;
 
 /**
- * @brief ModelMap is a multimap of all models and their cooresponding
- *        labels. Lables are referenced by index, stored in var labels
+ * @brief ModelMap holds all models and their cooresponding labels.
+ *        Lables are referenced by index, stored in var labels, and each
+ *        model cell has a bit mask of its labels, so that label filters are
+ *        a few bitwise AND/OR per model
  */
 
-class ModelMap : protected std::multimap<uint16_t, ModelCell *>
+class ModelMap
 {
  public:
-  ModelsVector getUnlabeledModels();
-  ModelsVector getAllModels();
-  ModelsVector getModelsByLabel(const std::string &);
-  ModelsVector getModelsByLabels(const LabelsVector &);
-  ModelsVector getModelsInLabels(const LabelsVector &lbls);
+  void forEachModelInLabels(const LabelsVector &lbls,
+                            const std::function<void(ModelCell *)> &fn);
+  bool hasUnlabeledModels();
+  bool hasModelsInLabel(const std::string &);
   LabelsVector getLabelsByModel(ModelCell *);
   std::map<std::string, bool> getSelectedLabels(ModelCell *);
   bool isLabelSelected(const std::string &, ModelCell *);
@@ -178,6 +191,7 @@ class ModelMap : protected std::multimap<uint16_t, ModelCell *>
   bool _isDirty = true;
   std::set<uint32_t> filtlbls;
   std::string currentlabel = "";
+  ModelsVector sortedModels;  // see forEachModelInLabels()
 
   void updateModelCell(ModelCell *);
   bool removeModels(
@@ -185,11 +199,11 @@ class ModelMap : protected std::multimap<uint16_t, ModelCell *>
   bool updateModelFile(ModelCell *);
   void sortModelsBy(ModelsVector &mv, ModelsSortBy sortby);
 
+  // the labels masks are dropped with the cells (ModelsList::clear())
   void clear()
   {
     _isDirty = true;
     labels.clear();
-    std::multimap<uint16_t, ModelCell *>::clear();
   }
 
   int getIndexByLabel(const std::string &str)
@@ -217,6 +231,7 @@ class ModelsList : public ModelsVector
   bool loaded;
 
   ModelCell *currentModel;
+  uint32_t pendingLabelsTime;  // 10ms ticks
 
   void init();
 
@@ -255,6 +270,9 @@ class ModelsList : public ModelsVector
   bool removeModel(ModelCell *model);
   bool moveModelTo(unsigned curindex, unsigned toindex);
 
+  bool writeModelLabels(ModelCell *cell);
+  void checkPendingLabels();
+
   bool isModelIdUnique(uint8_t moduleIdx, char *warn_buf, size_t warn_buf_len);
   uint8_t findNextUnusedModelId(uint8_t moduleIdx);
 
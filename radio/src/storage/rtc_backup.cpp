@@ -43,14 +43,149 @@ RamBackup * ramBackup = &_ramBackup;
 RamBackup * ramBackup = (RamBackup *)BKPSRAM_BASE;
 #endif
 
+// Once the full image has been written, only the changed blocks are appended
+// after it, until there is no room left. The changed blocks are found by
+// comparing each block with its last written data, read back from the backup
+// RAM: the last appended copy of the block, or else the compressed image.
+#define BACKUP_BLOCK_SIZE      64
+#define BACKUP_BLOCKS          ((sizeof(Backup::RamBackupUncompressed) + BACKUP_BLOCK_SIZE - 1) / BACKUP_BLOCK_SIZE)
+
+PACK(struct RamBackupDelta {
+  uint16_t block;
+  uint8_t data[BACKUP_BLOCK_SIZE];
+});
+
+// set once the full image has been written since boot
+static bool ramBackupImageWritten = false;
+
+static inline unsigned int rambackupBlockSize(unsigned int block)
+{
+  unsigned int offset = block * BACKUP_BLOCK_SIZE;
+  return min<unsigned int>(BACKUP_BLOCK_SIZE, sizeof(ramBackupUncompressed) - offset);
+}
+
+// Sequential reader of the RLC compressed image, same format as uncompress()
+class RamBackupImageReader
+{
+  public:
+    RamBackupImageReader(const uint8_t * src, unsigned int size):
+      src(src),
+      size(size)
+    {
+    }
+
+    bool read(uint8_t & value)
+    {
+      while (true) {
+        if (zeroes > 0) {
+          zeroes--;
+          value = 0;
+          return true;
+        }
+        if (size == 0) {
+          return false;
+        }
+        if (literals > 0) {
+          literals--;
+          size--;
+          value = *src++;
+          return true;
+        }
+        uint8_t rlc = *src++;
+        size--;
+        if (!(rlc & 0x7f)) {
+          return false;
+        }
+        if (rlc & 0x80) {
+          zeroes = (rlc >> 4) & 0x07;
+          literals = rlc & 0x0f;
+        }
+        else if (rlc & 0x40) {
+          zeroes = rlc & 0x3f;
+          literals = 0;
+        }
+        else {
+          literals = rlc;
+        }
+      }
+    }
+
+  protected:
+    const uint8_t * src;
+    unsigned int size;
+    uint8_t zeroes = 0;
+    uint8_t literals = 0;
+};
+
+static const RamBackupDelta * rambackupLastDelta(unsigned int block)
+{
+  const RamBackupDelta * result = nullptr;
+  for (unsigned int offset = ramBackup->size; offset < ramBackup->size + ramBackup->deltaSize; offset += sizeof(RamBackupDelta)) {
+    const RamBackupDelta * delta = (const RamBackupDelta *)&ramBackup->data[offset];
+    if (delta->block == block)
+      result = delta;
+  }
+  return result;
+}
+
+static bool rambackupWriteDelta()
+{
+  RamBackupImageReader image(ramBackup->data, ramBackup->size);
+  unsigned int offset = ramBackup->size + ramBackup->deltaSize;
+  unsigned int changes = 0;
+
+  for (unsigned int block = 0; block < BACKUP_BLOCKS; block++) {
+    const uint8_t * data = (const uint8_t *)&ramBackupUncompressed + block * BACKUP_BLOCK_SIZE;
+    unsigned int size = rambackupBlockSize(block);
+
+    // the image is read in any case, to stay at the next block
+    bool changed = false;
+    for (unsigned int i = 0; i < size; i++) {
+      uint8_t value;
+      if (!image.read(value))
+        return false;
+      changed |= (value != data[i]);
+    }
+
+    const RamBackupDelta * last = rambackupLastDelta(block);
+    if (last)
+      changed = (memcmp(last->data, data, size) != 0);
+    if (!changed)
+      continue;
+
+    if (offset + sizeof(RamBackupDelta) > sizeof(ramBackup->data))
+      return false;
+
+    RamBackupDelta * delta = (RamBackupDelta *)&ramBackup->data[offset];
+    delta->block = block;
+    memcpy(delta->data, data, size);
+    offset += sizeof(RamBackupDelta);
+    changes++;
+  }
+
+  // the blocks are taken into account only once they are all written
+  ramBackup->deltaSize = offset - ramBackup->size;
+
+  TRACE("RamBackupWrite %d blocks changed, deltasize=%d", changes, ramBackup->deltaSize);
+  return true;
+}
+
 void rambackupWrite()
 {
   copyRadioData(&ramBackupUncompressed.radio, &g_eeGeneral);
   copyModelData(&ramBackupUncompressed.model, &g_model);
+
+  if (ramBackupImageWritten && ramBackup->size > 0 && rambackupWriteDelta())
+    return;
+
+  ramBackup->size = 0;
+  ramBackup->deltaSize = 0;
   ramBackup->size = compress(ramBackup->data, sizeof(ramBackup->data),
                              (const uint8_t *)&ramBackupUncompressed,
                              sizeof(ramBackupUncompressed));
 
+  ramBackupImageWritten = (ramBackup->size > 0);
+
   TRACE("RamBackupWrite sdsize=%d backupsize=%d rlcsize=%d",
         sizeof(ModelData) + sizeof(RadioData),
         sizeof(Backup::RamBackupUncompressed), ramBackup->size);
@@ -58,12 +193,19 @@ void rambackupWrite()
 
 bool rambackupRestore()
 {
-  if (ramBackup->size == 0)
+  if (ramBackup->size == 0 || ramBackup->size + ramBackup->deltaSize > sizeof(ramBackup->data))
     return false;
 
   if (uncompress((uint8_t *)&ramBackupUncompressed, sizeof(ramBackupUncompressed), ramBackup->data, ramBackup->size) != sizeof(ramBackupUncompressed))
     return false;
 
+  for (unsigned int offset = ramBackup->size; offset + sizeof(RamBackupDelta) <= ramBackup->size + ramBackup->deltaSize; offset += sizeof(RamBackupDelta)) {
+    const RamBackupDelta * delta = (const RamBackupDelta *)&ramBackup->data[offset];
+    if (delta->block >= BACKUP_BLOCKS)
+      return false;
+    memcpy((uint8_t *)&ramBackupUncompressed + delta->block * BACKUP_BLOCK_SIZE, delta->data, rambackupBlockSize(delta->block));
+  }
+
   memset(&g_eeGeneral, 0, sizeof(g_eeGeneral));
   memset(&g_model, 0, sizeof(g_model));
   copyRadioData(&g_eeGeneral, &ramBackupUncompressed.radio);
@@ -24,9 +24,12 @@
 
 #include "definitions.h"
 
+// RLC compressed image of the model and radio settings (size bytes),
+// followed by the blocks changed since it was written (deltaSize bytes)
 PACK(struct RamBackup {
   uint16_t size;
-  uint8_t data[4094];
+  uint16_t deltaSize;
+  uint8_t data[4092];
 });
 
 extern RamBackup * ramBackup;
@@ -71,6 +71,12 @@ void storageFormat()
 
 void storageCheck(bool immediately)
 {
+  if (!storageDirtyMsk)
+    return;
+
+  DEBUG_TIMER_START(debugTimerStorageWrite);
+  TRACE_EVENT_BEGIN(trace_storage_write);
+
   if (storageDirtyMsk & EE_GENERAL) {
     TRACE("eeprom write general");
     storageDirtyMsk &= ~EE_GENERAL;
@@ -102,6 +108,14 @@ void storageCheck(bool immediately)
       TRACE("writeModel error=%s", error);
     }
   }
+
+  TRACE_EVENT_END(trace_storage_write);
+  DEBUG_TIMER_STOP(debugTimerStorageWrite);
+  storageLastLatency10ms = get_tmr10ms() - storagePendingTime10ms;
+  if (storageLastLatency10ms > storageMaxLatency10ms)
+    storageMaxLatency10ms = storageLastLatency10ms;
+  TRACE("storage written %dms after the first change",
+        (int)storageLastLatency10ms * 10);
 }
 
 #if defined(STORAGE_MODELSLIST)
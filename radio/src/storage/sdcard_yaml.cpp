@@ -235,22 +235,53 @@ bool YamlFileChecksum(const YamlNode* root_node, uint8_t* data, uint16_t* checks
 }
 
 
+// The tree walker outputs many small strings: they are gathered into a
+// small buffer before being handed to FatFs (which has its own sector buffer
+// in FIL), as each f_write() takes the volume lock, shared with the logs.
+#define YAML_WRITE_BUFFER_SIZE  64
+
 struct yaml_writer_ctx {
-    FIL*    file;
-    FRESULT result;
+    FIL*     file;
+    FRESULT  result;
+    uint16_t buffered;
+    uint8_t  buffer[YAML_WRITE_BUFFER_SIZE];
 };
 
-static bool yaml_writer(void* opaque, const char* str, size_t len)
+static bool yaml_writer_flush(yaml_writer_ctx* ctx)
 {
     UINT bytes_written;
+
+    if (ctx->buffered == 0)
+        return true;
+
+    ctx->result = f_write(ctx->file, ctx->buffer, ctx->buffered, &bytes_written);
+    if (ctx->result == FR_OK && bytes_written != ctx->buffered) {
+        // disk full: never report a truncated file as written
+        ctx->result = FR_DENIED;
+    }
+    ctx->buffered = 0;
+    return ctx->result == FR_OK;
+}
+
+static bool yaml_writer(void* opaque, const char* str, size_t len)
+{
     yaml_writer_ctx* ctx = (yaml_writer_ctx*)opaque;
 
 #if defined(DEBUG_YAML)
     TRACE_NOCRLF("%.*s",len,str);
 #endif
 
-    ctx->result = f_write(ctx->file, str, len, &bytes_written);
-    return (ctx->result == FR_OK) && (bytes_written == len);
+    while (len > 0) {
+        size_t count = min<size_t>(len, YAML_WRITE_BUFFER_SIZE - ctx->buffered);
+        memcpy(&ctx->buffer[ctx->buffered], str, count);
+        ctx->buffered += count;
+        str += count;
+        len -= count;
+        if (ctx->buffered == YAML_WRITE_BUFFER_SIZE && !yaml_writer_flush(ctx))
+            return false;
+    }
+
+    return true;
 }
 
 const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t* data, uint16_t checksum)
@@ -267,26 +298,32 @@ const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t*
     yaml_writer_ctx ctx;
     ctx.file = &file;
     ctx.result = FR_OK;
+    ctx.buffered = 0;
 
     // Try to add CRC
     if (checksum != 0) {
-      if (!yaml_writer(&ctx, YAMLFILE_CHECKSUM_TAG_NAME, strlen(YAMLFILE_CHECKSUM_TAG_NAME))) return NULL;
-      if (!yaml_writer(&ctx, ": ", 2)) return SDCARD_ERROR(FR_INVALID_PARAMETER);
-      const char* p_out = NULL;
-      p_out = yaml_unsigned2str((int)checksum);
-      if (p_out && !yaml_writer(&ctx, p_out, strlen(p_out))) return SDCARD_ERROR(FR_INVALID_PARAMETER);
+      yaml_writer(&ctx, YAMLFILE_CHECKSUM_TAG_NAME, strlen(YAMLFILE_CHECKSUM_TAG_NAME));
+      yaml_writer(&ctx, ": ", 2);
+      const char* p_out = yaml_unsigned2str((int)checksum);
+      if (p_out) yaml_writer(&ctx, p_out, strlen(p_out));
       yaml_writer(&ctx, "\r\n", 2);
     }
 
-
-    if (!tree.generate(yaml_writer, &ctx)) {
-        if (ctx.result != FR_OK) {
-            f_close(&file);
-            return SDCARD_ERROR(ctx.result);
-        }
+    if (ctx.result == FR_OK) {
+        tree.generate(yaml_writer, &ctx);
+    }
+    if (ctx.result == FR_OK) {
+        yaml_writer_flush(&ctx);
+    }
+    if (ctx.result != FR_OK) {
+        f_close(&file);
+        return SDCARD_ERROR(ctx.result);
     }
 
-    f_close(&file);
+    result = f_close(&file);
+    if (result != FR_OK) {
+        return SDCARD_ERROR(result);
+    }
     return NULL;
 }
 
@@ -315,6 +352,36 @@ const char * writeGeneralSettings()
 }
 
 
+#define MODEL_TMP_EXT       ".tmp"
+#define MODEL_TMP_PATH_LEN  (sizeof(MODELS_PATH) + LEN_MODEL_FILENAME + 1)
+
+// "/MODELS/model1.yml" -> "/MODELS/model1.tmp"
+static bool getModelTmpPath(char* tmpPath, const char* path)
+{
+    const char* ext = strrchr(path, '.');
+    size_t len = ext ? ext - path : strlen(path);
+    if (len + sizeof(MODEL_TMP_EXT) > MODEL_TMP_PATH_LEN)
+        return false;
+
+    memcpy(tmpPath, path, len);
+    memcpy(tmpPath + len, MODEL_TMP_EXT, sizeof(MODEL_TMP_EXT));
+    return true;
+}
+
+// A model write interrupted between removing the previous file and renaming
+// the new one leaves only the (complete) temporary file
+static bool recoverModelFile(const char* path)
+{
+    char tmpPath[MODEL_TMP_PATH_LEN];
+    FILINFO fno;
+
+    if (!getModelTmpPath(tmpPath, path) || f_stat(path, &fno) != FR_NO_FILE)
+        return false;
+
+    TRACE("recovering %s", tmpPath);
+    return f_rename(tmpPath, path) == FR_OK;
+}
+
 const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t size, const char* pathName)
 {
     // YAML reader
@@ -364,7 +431,11 @@ const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t siz
       md->rfAlarms.critical = 42;
     }
 
-    return readYamlFile(path, YamlTreeWalker::get_parser_calls(), &tree, NULL);
+    const char* error = readYamlFile(path, YamlTreeWalker::get_parser_calls(), &tree, NULL);
+    if (error && recoverModelFile(path)) {
+        error = readYamlFile(path, YamlTreeWalker::get_parser_calls(), &tree, NULL);
+    }
+    return error;
 }
 
 static const char _wrongExtentionError[] = "wrong file extension";
@@ -380,11 +451,36 @@ const char* readModel(const char* filename, uint8_t* buffer, uint32_t size, cons
 }
 
 const char * writeModelYaml(const char* filename)
+{
+    return writeModelYaml(filename, (uint8_t*)&g_model);
+}
+
+const char * writeModelYaml(const char* filename, uint8_t* data)
 {
     TRACE("YAML model writer");
     char path[256];
     getModelPath(path, filename);
-    return writeFileYaml(path, get_modeldata_nodes(), (uint8_t*)&g_model,0 );
+
+    // Like the radio settings, the model is written to a temporary file
+    // which then replaces the model file: a write interrupted by a power
+    // off never leaves a truncated model behind
+    char tmpPath[MODEL_TMP_PATH_LEN];
+    if (!getModelTmpPath(tmpPath, path)) {
+        return writeFileYaml(path, get_modeldata_nodes(), data, 0);
+    }
+
+    const char* error = writeFileYaml(tmpPath, get_modeldata_nodes(), data, 0);
+    if (error) {
+        f_unlink(tmpPath);
+        return error;
+    }
+    f_unlink(path);
+
+    FRESULT result = f_rename(tmpPath, path);
+    if (result != FR_OK)
+        return SDCARD_ERROR(result);
+
+    return nullptr;
 }
 
 #if !defined(STORAGE_MODELSLIST)
@@ -34,6 +34,10 @@
 
 extern uint8_t   storageDirtyMsk;
 extern tmr10ms_t storageDirtyTime10ms;
+extern tmr10ms_t storagePendingTime10ms;
+// time from the first change to the end of its write
+extern tmr10ms_t storageLastLatency10ms;
+extern tmr10ms_t storageMaxLatency10ms;
 #define TIME_TO_WRITE()                (storageDirtyMsk && (tmr10ms_t)(get_tmr10ms() - storageDirtyTime10ms) >= (tmr10ms_t)WRITE_DELAY_10MS)
 
 #if defined(RTC_BACKUP_RAM)
@@ -36,6 +36,9 @@
 
 uint8_t   storageDirtyMsk;
 tmr10ms_t storageDirtyTime10ms;
+tmr10ms_t storagePendingTime10ms;
+tmr10ms_t storageLastLatency10ms;
+tmr10ms_t storageMaxLatency10ms;
 
 #if defined(RTC_BACKUP_RAM)
 uint8_t   rambackupDirtyMsk = EE_GENERAL | EE_MODEL;
@@ -44,8 +47,14 @@ tmr10ms_t rambackupDirtyTime10ms;
 
 void storageDirty(uint8_t msk)
 {
+  tmr10ms_t now = get_tmr10ms();
+  if (!storageDirtyMsk) {
+    // first change since the last write
+    storagePendingTime10ms = now;
+  }
   storageDirtyMsk |= msk;
-  storageDirtyTime10ms = get_tmr10ms();
+  storageDirtyTime10ms = now;
+  customFunctionsChanged();
 
 #if defined(RTC_BACKUP_RAM)
   rambackupDirtyMsk = storageDirtyMsk;
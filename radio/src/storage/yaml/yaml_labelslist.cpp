@@ -136,6 +136,10 @@ static bool find_node(void* ctx, char* buf, uint8_t len)
             break;
           }
           ModelCell *model = new ModelCell(mi->current_attr);
+          if(!model) {
+            TRACE_LABELS_YAML("    No memory left for a modelcell");
+            break;
+          }
           strcpy(model->modelFinfoHash, filehash.hash);
           modelslist.push_back(model);
           filehash.celladded = true;
@@ -224,6 +228,11 @@ static void set_attr(void* ctx, char* buf, uint16_t len)
           TRACE_LABELS_YAML("  Adding the label - %s", lbl.c_str());
         }
 
+      // Labels not yet written into the model file
+      } else if(!strcasecmp(mi->current_attr, "pending")) {
+        mi->curmodel->_labelsPending = strtol(value, NULL, 10) != 0;
+        TRACE_LABELS_YAML(" Labels pending");
+
       // RF Module Data
       } else {
         char cmp[15];
@@ -695,7 +695,9 @@ DRESULT disk_read (
 {
   if (drv || !count) return RES_PARERR;
   if (Stat & STA_NOINIT) return RES_NOTRDY;
+  TRACE_EVENT_BEGIN(trace_sd_read);
   int8_t res = SD_ReadSectors(buff, sector, count);
+  TRACE_EVENT_END(trace_sd_read);
   TRACE_SD_CARD_EVENT((res != 0), sd_disk_read, (count << 24) + (sector & 0x00FFFFFF));
   return (res != 0) ? RES_ERROR : RES_OK;
 }
@@ -750,7 +752,9 @@ DRESULT disk_write (
   if (drv || !count) return RES_PARERR;
   if (Stat & STA_NOINIT) return RES_NOTRDY;
   if (Stat & STA_PROTECT) return RES_WRPRT;
+  TRACE_EVENT_BEGIN(trace_sd_write);
   int8_t res = SD_WriteSectors(buff, sector, count);
+  TRACE_EVENT_END(trace_sd_write);
   TRACE_SD_CARD_EVENT((res != 0), sd_disk_write, (count << 24) + (sector & 0x00FFFFFF));
   return (res != 0) ? RES_ERROR : RES_OK;
 }
@@ -25,6 +25,12 @@
 #include "tasks.h"
 #include "tasks/mixer_task.h"
 
+#if !defined(SIMU)
+extern "C" {
+  #include <FreeRTOS/include/timers.h>
+}
+#endif
+
 RTOS_TASK_HANDLE menusTaskId;
 RTOS_DEFINE_STACK(menusTaskId, menusStack, MENUS_STACK_SIZE);
 
@@ -73,6 +79,7 @@ TASK_FUNCTION(menusTask)
 #endif
     uint32_t start = (uint32_t)RTOS_GET_TIME();
     DEBUG_TIMER_START(debugTimerPerMain);
+    TRACE_EVENT_BEGIN(trace_menus);
 #if defined(COLORLCD) && defined(CLI)
     if (perMainEnabled) {
       perMain();
@@ -80,6 +87,7 @@ TASK_FUNCTION(menusTask)
 #else
     perMain();
 #endif
+    TRACE_EVENT_END(trace_menus);
     DEBUG_TIMER_STOP(debugTimerPerMain);
     // TODO remove completely massstorage from sky9x firmware
     uint32_t runtime = ((uint32_t)RTOS_GET_TIME() - start);
@@ -103,6 +111,102 @@ TASK_FUNCTION(menusTask)
   TASK_RETURN();
 }
 
+#if defined(CLI)
+extern RTOS_TASK_HANDLE cliTaskId;
+#endif
+
+static const char * const taskNames[TASK_COUNT] = {
+  "menus", "mixer", "audio", "cli", "timer", "idle"
+};
+
+// CPU cycles spent in each task, updated on each context switch
+static volatile uint32_t taskTime[TASK_COUNT];
+static uint32_t taskTimeLast[TASK_COUNT];
+static uint16_t taskCpuLoad[TASK_COUNT];
+
+#if !defined(SIMU)
+static uint8_t getTaskIndex(const void * tcb)
+{
+  if (tcb == mixerTaskId.rtos_handle)
+    return TASK_MIXER;
+  if (tcb == audioTaskId.rtos_handle)
+    return TASK_AUDIO;
+  if (tcb == menusTaskId.rtos_handle)
+    return TASK_MENUS;
+#if defined(CLI)
+  if (tcb == cliTaskId.rtos_handle)
+    return TASK_CLI;
+#endif
+  if (tcb == xTimerGetTimerDaemonTaskHandle())
+    return TASK_TIMER;
+  return TASK_IDLE;
+}
+
+// called by the scheduler (traceTASK_SWITCHED_IN) with interrupts disabled
+extern "C" void tasksSwitchedIn(const void * tcb)
+{
+  static uint8_t currentTask = TASK_IDLE;
+  static uint32_t lastSwitch;
+
+  uint32_t now = ticksNow();
+  taskTime[currentTask] += now - lastSwitch;
+  lastSwitch = now;
+  currentTask = getTaskIndex(tcb);
+}
+#endif
+
+void tasksUpdateCpuLoad()
+{
+  uint32_t elapsed[TASK_COUNT];
+  uint32_t total = 0;
+
+  // the cycles counter wraps around, the window must stay below ~20s
+  for (uint8_t i = 0; i < TASK_COUNT; i++) {
+    uint32_t time = taskTime[i];
+    elapsed[i] = time - taskTimeLast[i];
+    taskTimeLast[i] = time;
+    total += elapsed[i];
+  }
+
+  for (uint8_t i = 0; i < TASK_COUNT; i++) {
+    taskCpuLoad[i] = total ? (uint64_t)elapsed[i] * 1000 / total : 0;
+  }
+}
+
+const char * getTaskName(uint8_t task)
+{
+  return task < TASK_COUNT ? taskNames[task] : "";
+}
+
+uint16_t getTaskCpuLoad(uint8_t task)
+{
+  return task < TASK_COUNT ? taskCpuLoad[task] : 0;
+}
+
+uint32_t getTaskStackAvailable(uint8_t task)
+{
+  switch (task) {
+    case TASK_MENUS:
+      return menusStack.available() * 4;
+    case TASK_MIXER:
+      return mixerStack.available() * 4;
+    case TASK_AUDIO:
+      return audioStack.available() * 4;
+#if defined(CLI)
+    case TASK_CLI:
+      return cliStack.available() * 4;
+#endif
+#if !defined(SIMU)
+    case TASK_TIMER:
+      return uxTaskGetStackHighWaterMark(xTimerGetTimerDaemonTaskHandle()) * 4;
+    case TASK_IDLE:
+      return uxTaskGetStackHighWaterMark(xTaskGetIdleTaskHandle()) * 4;
+#endif
+    default:
+      return 0;
+  }
+}
+
 void tasksStart()
 {
   RTOS_CREATE_MUTEX(audioMutex);
@@ -57,6 +57,28 @@ extern TaskStack<CLI_STACK_SIZE> cliStack;
 
 void tasksStart();
 
+enum TaskIndex {
+  TASK_MENUS,
+  TASK_MIXER,
+  TASK_AUDIO,
+  TASK_CLI,
+  TASK_TIMER,
+  TASK_IDLE,
+  TASK_COUNT
+};
+
+const char * getTaskName(uint8_t task);
+
+// CPU time used by the task during the last second, in 0.1%
+// (interrupts are accounted to the task they interrupt)
+uint16_t getTaskCpuLoad(uint8_t task);
+
+// stack high-water mark, in bytes
+uint32_t getTaskStackAvailable(uint8_t task);
+
+// called every second
+void tasksUpdateCpuLoad();
+
 extern volatile uint16_t timeForcePowerOffPressed;
 inline void resetForcePowerOffRequest()
 {
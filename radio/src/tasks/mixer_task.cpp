@@ -93,6 +93,26 @@ bool mixerTaskRunning()
   return _mixer_running && !_mixer_exit;
 }
 
+MixerTimingStats mixerTimingStats;
+
+bool MixerTimingStats::add(uint16_t duration, uint16_t period)
+{
+  uint32_t deadline = 2 * (uint32_t)period;
+  uint8_t bin = MIXER_DURATION_BINS - 1;
+  if (duration < deadline) {
+    bin = (uint32_t)duration * (MIXER_DURATION_BINS - 1) / deadline;
+  }
+  if (histogram[bin] < UINT16_MAX) {
+    histogram[bin]++;
+  }
+  return bin == MIXER_DURATION_BINS - 1;
+}
+
+void MixerTimingStats::reset()
+{
+  memset(this, 0, sizeof(MixerTimingStats));
+}
+
 volatile uint16_t timeForcePowerOffPressed = 0;
 
 bool isForcePowerOffRequested()
@@ -135,7 +155,9 @@ void execMixerFrequentActions()
 #if defined(SIMU)
   if (_mixer_running) {
     DEBUG_TIMER_START(debugTimerTelemetryWakeup);
+    TRACE_EVENT_BEGIN(trace_telemetry);
     telemetryWakeup();
+    TRACE_EVENT_END(trace_telemetry);
     DEBUG_TIMER_STOP(debugTimerTelemetryWakeup);
   }
 #endif
@@ -150,6 +172,9 @@ TASK_FUNCTION(mixerTask)
   mixerSchedulerInit();
   mixerSchedulerStart();
 
+  bool lastCycleLate = false;
+  bool updatesDeferred = false;
+
   while (!_mixer_exit) {
 
     int timeout = 0;
@@ -193,9 +218,24 @@ TASK_FUNCTION(mixerTask)
       DEBUG_TIMER_START(debugTimerMixer);
       mixerTaskLock();
 
+      TRACE_EVENT_BEGIN(trace_mixer);
       doMixerCalculations();
+      TRACE_EVENT_END(trace_mixer);
+
+      TRACE_EVENT_BEGIN(trace_pulses);
       pulsesSendChannels();
-      doMixerPeriodicUpdates();
+      TRACE_EVENT_END(trace_pulses);
+
+      // a late cycle delays the next one: give it some slack by
+      // running the periodic updates only every other cycle
+      if (g_eeGeneral.mixerDeferOnOverrun && lastCycleLate && !updatesDeferred) {
+        updatesDeferred = true;
+        mixerTimingStats.deferredUpdates++;
+      }
+      else {
+        doMixerPeriodicUpdates();
+        updatesDeferred = false;
+      }
 
       // TODO: what are these for???
       DEBUG_TIMER_START(debugTimerMixerCalcToUsage);
@@ -217,6 +257,8 @@ TASK_FUNCTION(mixerTask)
       t0 = getTmr2MHz() - t0;
       if (t0 > maxMixerDuration)
         maxMixerDuration = t0;
+
+      lastCycleLate = mixerTimingStats.add(t0, getMixerSchedulerPeriod());
     }
   }
 
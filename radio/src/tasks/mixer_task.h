@@ -78,3 +78,32 @@ void mixerTaskUnlock();
 // returns true if the lock could be acquired
 bool mixerTaskTryLock();
 
+//
+// Mixer cycles timing
+//
+// Each cycle (from the trigger to the end of the periodic updates) is
+// compared to the scheduler period: the last bin of the histogram counts
+// the cycles which missed their deadline.
+//
+#define MIXER_DURATION_BINS  5  // < 25%, < 50%, < 75%, < 100%, late
+
+struct MixerTimingStats {
+  uint16_t histogram[MIXER_DURATION_BINS];
+  uint16_t deferredUpdates;
+
+  // duration in 2MHz ticks, period in us, returns true if late
+  bool add(uint16_t duration, uint16_t period);
+
+  uint16_t deadlineMisses() const
+  {
+    return histogram[MIXER_DURATION_BINS - 1];
+  }
+
+  void reset();
+};
+
+extern MixerTimingStats mixerTimingStats;
+
+// g_eeGeneral.mixerDeferOnOverrun: after a late cycle, skip the periodic
+// updates (timers, logical switches timers, ...) of the next cycle, they are
+// caught up on the following one (radio hardware settings, off by default)
@@ -58,28 +58,52 @@ const CrossfireSensor crossfireSensors[] = {
   {0,              0, "UNKNOWN",          UNIT_RAW,               0},
 };
 
+// Values at a fixed position in their frame, big endian and signed
+struct CrossfireField {
+  uint8_t frameId;
+  uint8_t offset;   // in the frame, the payload starts at 3
+  uint8_t size;     // in bytes
+  uint8_t index;    // in crossfireSensors
+  int8_t scale;     // multiplier if > 0, divider if < 0
+  int16_t bias;     // added after scaling
+};
+
+static const CrossfireField crossfireFields[] = {
+  {GPS_ID,       3,  4, GPS_LATITUDE_INDEX,     -10,     0},
+  {GPS_ID,       7,  4, GPS_LONGITUDE_INDEX,    -10,     0},
+  {GPS_ID,       11, 2, GPS_GROUND_SPEED_INDEX,   1,     0},
+  {GPS_ID,       13, 2, GPS_HEADING_INDEX,        1,     0},
+  {GPS_ID,       15, 2, GPS_ALTITUDE_INDEX,       1, -1000},
+  {GPS_ID,       17, 1, GPS_SATELLITES_INDEX,     1,     0},
+  {CF_VARIO_ID,  3,  2, VERTICAL_SPEED_INDEX,     1,     0},
+  {BATTERY_ID,   3,  2, BATT_VOLTAGE_INDEX,       1,     0},
+  {BATTERY_ID,   5,  2, BATT_CURRENT_INDEX,       1,     0},
+  {BATTERY_ID,   7,  3, BATT_CAPACITY_INDEX,      1,     0},
+  {BATTERY_ID,   10, 1, BATT_REMAINING_INDEX,     1,     0},
+  {LINK_RX_ID,   4,  1, RX_RSSI_PERC_INDEX,       1,     0},
+  {LINK_RX_ID,   7,  1, TX_RF_POWER_INDEX,        1,     0},
+  {LINK_TX_ID,   4,  1, TX_RSSI_PERC_INDEX,       1,     0},
+  {LINK_TX_ID,   7,  1, RX_RF_POWER_INDEX,        1,     0},
+  {LINK_TX_ID,   8,  1, TX_FPS_INDEX,            10,     0},
+  {ATTITUDE_ID,  3,  2, ATTITUDE_PITCH_INDEX,   -10,     0},
+  {ATTITUDE_ID,  5,  2, ATTITUDE_ROLL_INDEX,    -10,     0},
+  {ATTITUDE_ID,  7,  2, ATTITUDE_YAW_INDEX,     -10,     0},
+};
+
 const CrossfireSensor & getCrossfireSensor(uint8_t id, uint8_t subId)
 {
-  if (id == LINK_ID)
-    return crossfireSensors[RX_RSSI1_INDEX + subId];
-  else if (id == LINK_RX_ID)
-    return crossfireSensors[RX_RSSI_PERC_INDEX + subId];
-  else if (id == LINK_TX_ID)
-    return crossfireSensors[TX_RSSI_PERC_INDEX + subId];
-  else if (id == BATTERY_ID)
-    return crossfireSensors[BATT_VOLTAGE_INDEX + subId];
-  else if (id == GPS_ID)
-    return crossfireSensors[GPS_LATITUDE_INDEX + subId];
-  else if (id == CF_VARIO_ID)
-    return crossfireSensors[VERTICAL_SPEED_INDEX];
-  else if (id == ATTITUDE_ID)
-    return crossfireSensors[ATTITUDE_PITCH_INDEX + subId];
-  else if (id == FLIGHT_MODE_ID)
-    return crossfireSensors[FLIGHT_MODE_INDEX];
-  else if (id == BARO_ALT_ID)
-    return crossfireSensors[BARO_ALTITUDE_INDEX];
-  else
-    return crossfireSensors[UNKNOWN_INDEX];
+  // frames with a single sensor match any subId
+  const CrossfireSensor * result = &crossfireSensors[UNKNOWN_INDEX];
+  for (unsigned i = 0; i < UNKNOWN_INDEX; i++) {
+    const CrossfireSensor & sensor = crossfireSensors[i];
+    if (sensor.id == id) {
+      if (sensor.subId == subId)
+        return sensor;
+      if (result == &crossfireSensors[UNKNOWN_INDEX])
+        result = &sensor;
+    }
+  }
+  return *result;
 }
 
 void processCrossfireTelemetryValue(uint8_t index, int32_t value)
@@ -92,14 +116,13 @@ void processCrossfireTelemetryValue(uint8_t index, int32_t value)
                     value, sensor.unit, sensor.precision);
 }
 
-template<int N>
-bool getCrossfireTelemetryValue(uint8_t index, int32_t & value, uint8_t module)
+static bool getCrossfireTelemetryValue(uint8_t index, uint8_t size, int32_t & value, uint8_t module)
 {
   uint8_t * rxBuffer = getTelemetryRxBuffer(module);
   bool result = false;
   uint8_t * byte = &rxBuffer[index];
   value = (*byte & 0x80) ? -1 : 0;
-  for (uint8_t i=0; i<N; i++) {
+  for (uint8_t i=0; i<size; i++) {
     value <<= 8;
     if (*byte != 0xff) {
       result = true;
@@ -109,6 +132,36 @@ bool getCrossfireTelemetryValue(uint8_t index, int32_t & value, uint8_t module)
   return result;
 }
 
+template<int N>
+bool getCrossfireTelemetryValue(uint8_t index, int32_t & value, uint8_t module)
+{
+  return getCrossfireTelemetryValue(index, N, value, module);
+}
+
+// returns false if the frame has no field in the table
+static bool processCrossfireFields(uint8_t id, uint8_t module)
+{
+  uint8_t * rxBuffer = getTelemetryRxBuffer(module);
+  uint8_t crsfPayloadLen = rxBuffer[1];
+  bool found = false;
+
+  for (const auto & field : crossfireFields) {
+    if (field.frameId != id)
+      continue;
+    found = true;
+    // the last byte of the frame is the CRC
+    if (field.offset + field.size > crsfPayloadLen + 1)
+      continue;
+    int32_t value;
+    if (getCrossfireTelemetryValue(field.offset, field.size, value, module)) {
+      value = (field.scale > 0 ? value * field.scale : value / -field.scale) + field.bias;
+      processCrossfireTelemetryValue(field.index, value);
+    }
+  }
+
+  return found;
+}
+
 void processCrossfireTelemetryFrame(uint8_t module)
 {
   uint8_t * rxBuffer = getTelemetryRxBuffer(module);
@@ -121,28 +174,11 @@ void processCrossfireTelemetryFrame(uint8_t module)
 
   uint8_t crsfPayloadLen = rxBuffer[1];
   uint8_t id = rxBuffer[2];
+  if (processCrossfireFields(id, module))
+    return;
+
   int32_t value;
   switch(id) {
-    case CF_VARIO_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
-        processCrossfireTelemetryValue(VERTICAL_SPEED_INDEX, value);
-      break;
-
-    case GPS_ID:
-      if (getCrossfireTelemetryValue<4>(3, value, module))
-        processCrossfireTelemetryValue(GPS_LATITUDE_INDEX, value/10);
-      if (getCrossfireTelemetryValue<4>(7, value, module))
-        processCrossfireTelemetryValue(GPS_LONGITUDE_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(11, value, module))
-        processCrossfireTelemetryValue(GPS_GROUND_SPEED_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(13, value, module))
-        processCrossfireTelemetryValue(GPS_HEADING_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(15, value, module))
-        processCrossfireTelemetryValue(GPS_ALTITUDE_INDEX,  value - 1000);
-      if (getCrossfireTelemetryValue<1>(17, value, module))
-        processCrossfireTelemetryValue(GPS_SATELLITES_INDEX, value);
-      break;
-
     case BARO_ALT_ID:
       if (getCrossfireTelemetryValue<2>(3, value, module)) {
         if (value & 0x8000) {
@@ -190,42 +226,6 @@ void processCrossfireTelemetryFrame(uint8_t module)
       }
       break;
 
-    case LINK_RX_ID:
-      if (getCrossfireTelemetryValue<1>(4, value, module))
-        processCrossfireTelemetryValue(RX_RSSI_PERC_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(7, value, module))
-        processCrossfireTelemetryValue(TX_RF_POWER_INDEX, value);
-      break;
-
-    case LINK_TX_ID:
-      if (getCrossfireTelemetryValue<1>(4, value, module))
-        processCrossfireTelemetryValue(TX_RSSI_PERC_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(7, value, module))
-        processCrossfireTelemetryValue(RX_RF_POWER_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(8, value, module))
-        processCrossfireTelemetryValue(TX_FPS_INDEX, value * 10);
-      break;
-
-    case BATTERY_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
-        processCrossfireTelemetryValue(BATT_VOLTAGE_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(5, value, module))
-        processCrossfireTelemetryValue(BATT_CURRENT_INDEX, value);
-      if (getCrossfireTelemetryValue<3>(7, value, module))
-        processCrossfireTelemetryValue(BATT_CAPACITY_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(10, value, module))
-        processCrossfireTelemetryValue(BATT_REMAINING_INDEX, value);
-      break;
-
-    case ATTITUDE_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
-        processCrossfireTelemetryValue(ATTITUDE_PITCH_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(5, value, module))
-        processCrossfireTelemetryValue(ATTITUDE_ROLL_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(7, value, module))
-        processCrossfireTelemetryValue(ATTITUDE_YAW_INDEX, value/10);
-      break;
-
     case FLIGHT_MODE_ID:
     {
       const CrossfireSensor & sensor = crossfireSensors[FLIGHT_MODE_INDEX];
@@ -24,6 +24,7 @@
 #include "pulses/afhds3.h"
 #include "pulses/flysky.h"
 #include "mixer_scheduler.h"
+#include "tasks/mixer_task.h"
 #include "io/multi_protolist.h"
 #include "hal/module_port.h"
 
@@ -211,7 +212,9 @@ static void telemetryTimerCb(TimerHandle_t xTimer)
   (void)xTimer;
 
   DEBUG_TIMER_START(debugTimerTelemetryWakeup);
+  TRACE_EVENT_BEGIN(trace_telemetry);
   telemetryWakeup();
+  TRACE_EVENT_END(trace_telemetry);
   DEBUG_TIMER_STOP(debugTimerTelemetryWakeup);
 }
 
@@ -580,15 +583,20 @@ void ModuleSyncStatus::getRefreshString(char * statusText)
     return;
   }
 
+  // mixer cycles which missed the module period are marked with a '!'
+  // (the count is on the debug statistics page), it must fit 128x64
+  bool late = mixerTimingStats.deadlineMisses() > 0;
+
   char * tmp = statusText;
 #if defined(DEBUG)
   *tmp++ = 'L';
   tmp = strAppendSigned(tmp, inputLag, 5);
   tmp = strAppend(tmp, "R");
   tmp = strAppendUnsigned(tmp, refreshRate, 5);
+  tmp = strAppend(tmp, late ? "us!" : "us");
 #else
-  tmp = strAppend(tmp, "Sync ");
+  tmp = strAppend(tmp, late ? "Sync!" : "Sync ");
   tmp = strAppendUnsigned(tmp, refreshRate);
-#endif
   tmp = strAppend(tmp, "us");
+#endif
 }
@@ -19,7 +19,10 @@
  * GNU General Public License for more details.
  */
 
+#include <chrono>
+
 #include "gtests.h"
+#include "pulses/channels_packer.h"
 
 #if defined(CROSSFIRE)
 uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
@@ -28,14 +31,138 @@ TEST(Crossfire, createCrossfireChannelsFrame)
   int16_t pulsesStart[MAX_TRAINER_CHANNELS];
   uint8_t crossfire[CROSSFIRE_FRAME_MAXLEN];
 
+  MODEL_RESET();
+  memset(crossfire, 0, sizeof(crossfire));
+  for (int i=0; i<MAX_TRAINER_CHANNELS; i++) {
+    pulsesStart[i] = -1024 + (2048 / MAX_TRAINER_CHANNELS) * i;
+  }
+
+  uint8_t len = createCrossfireChannelsFrame(crossfire, pulsesStart);
+  ASSERT_EQ(26, len);
+  ASSERT_EQ(CHANNELS_ID, crossfire[2]);
+
+  ChannelsUnpacker<11> unpacker(&crossfire[3]);
+  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+    int value = 0x3E0 + (pulsesStart[i] * 4) / 5;
+    EXPECT_EQ(limit(0, value, 2 * 0x3E0), (int)unpacker.pop());
+  }
+  ASSERT_EQ(crc8(&crossfire[2], 23), crossfire[25]);
+}
+
+uint8_t createCrossfireSubsetChannelsFrame(uint8_t * frame, int16_t * pulses, uint8_t start, uint8_t count);
+TEST(Crossfire, createCrossfireSubsetChannelsFrame)
+{
+  int16_t pulsesStart[MAX_TRAINER_CHANNELS];
+  uint8_t crossfire[CROSSFIRE_FRAME_MAXLEN];
+
+  MODEL_RESET();
   memset(crossfire, 0, sizeof(crossfire));
   for (int i=0; i<MAX_TRAINER_CHANNELS; i++) {
     pulsesStart[i] = -1024 + (2048 / MAX_TRAINER_CHANNELS) * i;
   }
 
-  createCrossfireChannelsFrame(crossfire, pulsesStart);
+  // 4 channels = 44 bits = 6 bytes
+  uint8_t len = createCrossfireSubsetChannelsFrame(crossfire, pulsesStart, 4, 4);
+  ASSERT_EQ(11, len);
+  ASSERT_EQ(len - 2, crossfire[1]);
+  ASSERT_EQ(SUBSET_CHANNELS_ID, crossfire[2]);
+  ASSERT_EQ(4 | (1 << 5), crossfire[3]);
+
+  // 0.5us per step, 1024 = 1500us
+  ChannelsUnpacker<11> unpacker(&crossfire[4]);
+  for (int i=4; i<8; i++) {
+    EXPECT_EQ(1024 + pulsesStart[i], (int)unpacker.pop());
+  }
+  ASSERT_EQ(crc8(&crossfire[2], len - 3), crossfire[len - 1]);
+}
+
+TEST(Crossfire, subsetChannelsOptIn)
+{
+  MODEL_RESET();
+  g_model.moduleData[EXTERNAL_MODULE].type = MODULE_TYPE_CROSSFIRE;
+  g_model.moduleData[EXTERNAL_MODULE].channelsCount = 8 - 8;
+
+  // full CHANNELS_ID frames unless enabled in the model
+  EXPECT_EQ(CROSSFIRE_CHANNELS_COUNT, sentModuleChannels(EXTERNAL_MODULE));
+  EXPECT_EQ(CROSSFIRE_CHANNELS_COUNT, minModuleChannels(EXTERNAL_MODULE));
+
+  g_model.moduleData[EXTERNAL_MODULE].crsf.subsetChannels = 1;
+  EXPECT_EQ(8, sentModuleChannels(EXTERNAL_MODULE));
+  EXPECT_EQ(CROSSFIRE_MIN_CHANNELS_COUNT, minModuleChannels(EXTERNAL_MODULE));
+}
+
+TEST(Crossfire, channelsPacker)
+{
+  uint8_t buffer[32];
+  uint8_t * p = buffer;
+  {
+    ChannelsPacker<11> packer(p);
+    for (int i=0; i<16; i++) {
+      packer.push((i * 131) & 0x7FF);
+    }
+  }
+  ASSERT_EQ(22, p - buffer);
+
+  ChannelsUnpacker<11> unpacker(buffer);
+  for (int i=0; i<16; i++) {
+    EXPECT_EQ((uint32_t)((i * 131) & 0x7FF), unpacker.pop());
+  }
+
+  // incomplete last byte
+  p = buffer;
+  packChannels<12>(p, 3, [](uint8_t i) -> uint32_t { return 0xFFF - i; });
+  ASSERT_EQ(5, p - buffer);
+  EXPECT_EQ(0xFF, buffer[0]);
+  EXPECT_EQ(0xEF, buffer[1]);
+  EXPECT_EQ(0xFF, buffer[2]);
+  EXPECT_EQ(0xFD, buffer[3]);
+  EXPECT_EQ(0x0F, buffer[4]);
+}
+
+// Packing speed against the loop the protocols used before ChannelsPacker.
+// Not run by default: --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST(Crossfire, DISABLED_channelsPackerBenchmark)
+{
+  const int frames = 1000000;
+  uint8_t buffer[32];
+  int16_t pulses[16];
+  for (int i=0; i<16; i++) {
+    pulses[i] = -1024 + 128 * i;
+  }
+
+  auto scale = [&](uint8_t i) -> uint32_t {
+    return limit(0, 0x3E0 + (pulses[i] * 4) / 5, 2 * 0x3E0);
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  for (int f=0; f<frames; f++) {
+    uint8_t * buf = buffer;
+    uint32_t bits = 0;
+    uint8_t bitsavailable = 0;
+    for (int i=0; i<16; i++) {
+      bits |= scale(i) << bitsavailable;
+      bitsavailable += 11;
+      while (bitsavailable >= 8) {
+        *buf++ = bits;
+        bits >>= 8;
+        bitsavailable -= 8;
+      }
+    }
+    pulses[f & 15] ^= buffer[f % 22] & 1;
+  }
+  auto loop = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int f=0; f<frames; f++) {
+    uint8_t * buf = buffer;
+    packChannels<11>(buf, 16, scale);
+    pulses[f & 15] ^= buffer[f % 22] & 1;
+  }
+  auto packer = std::chrono::steady_clock::now() - start;
 
-  // TODO check
+  printf("16 channels x 11 bits: loop %.1f ns/frame, ChannelsPacker %.1f ns/frame\n",
+         std::chrono::duration<double, std::nano>(loop).count() / frames,
+         std::chrono::duration<double, std::nano>(packer).count() / frames);
 }
 
 TEST(Crossfire, crc8)
@@ -44,5 +171,145 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
+
+static void processCrossfireTestFrame(const uint8_t * frame, uint8_t len)
+{
+  memcpy(getTelemetryRxBuffer(EXTERNAL_MODULE), frame, len);
+  getTelemetryRxBufferCount(EXTERNAL_MODULE) = len;
+  processCrossfireTelemetryFrame(EXTERNAL_MODULE);
+}
+
+TEST(Crossfire, telemetryFrames)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  // 12.3V, 1.0A, 500mAh, 75%
+  const uint8_t battery[] = { 0xEA, 0x0A, BATTERY_ID, 0x00, 0x7B, 0x00, 0x0A, 0x00, 0x01, 0xF4, 0x4B, 0x00 };
+  processCrossfireTestFrame(battery, sizeof(battery));
+  EXPECT_EQ(telemetryItems[0].value, 123);
+  EXPECT_EQ(telemetryItems[1].value, 10);
+  EXPECT_EQ(telemetryItems[2].value, 500);
+  EXPECT_EQ(telemetryItems[3].value, 75);
+
+  // -2.00m/s
+  const uint8_t vario[] = { 0xEA, 0x04, CF_VARIO_ID, 0xFF, 0x38, 0x00 };
+  processCrossfireTestFrame(vario, sizeof(vario));
+  EXPECT_EQ(telemetryItems[4].value, -200);
+
+  // truncated frame: the remaining percentage is not in the payload
+  const uint8_t truncated[] = { 0xEA, 0x09, BATTERY_ID, 0x00, 0x7C, 0x00, 0x0A, 0x00, 0x01, 0xF4, 0x00 };
+  processCrossfireTestFrame(truncated, sizeof(truncated));
+  EXPECT_EQ(telemetryItems[0].value, 124);
+  EXPECT_EQ(telemetryItems[3].value, 75);
+}
+
+void processCrossfireTelemetryValue(uint8_t index, int32_t value);
+
+template<int N>
+static bool getHandWrittenValue(const uint8_t * rxBuffer, uint8_t index, int32_t & value)
+{
+  bool result = false;
+  const uint8_t * byte = &rxBuffer[index];
+  value = (*byte & 0x80) ? -1 : 0;
+  for (uint8_t i=0; i<N; i++) {
+    value <<= 8;
+    if (*byte != 0xff) {
+      result = true;
+    }
+    value += *byte++;
+  }
+  return result;
+}
+
+// The decoding of these frames before the crossfireFields table
+static void processHandWrittenFrame(const uint8_t * rxBuffer)
+{
+  int32_t value;
+  switch (rxBuffer[2]) {
+    case GPS_ID:
+      if (getHandWrittenValue<4>(rxBuffer, 3, value))
+        processCrossfireTelemetryValue(GPS_LATITUDE_INDEX, value/10);
+      if (getHandWrittenValue<4>(rxBuffer, 7, value))
+        processCrossfireTelemetryValue(GPS_LONGITUDE_INDEX, value/10);
+      if (getHandWrittenValue<2>(rxBuffer, 11, value))
+        processCrossfireTelemetryValue(GPS_GROUND_SPEED_INDEX, value);
+      if (getHandWrittenValue<2>(rxBuffer, 13, value))
+        processCrossfireTelemetryValue(GPS_HEADING_INDEX, value);
+      if (getHandWrittenValue<2>(rxBuffer, 15, value))
+        processCrossfireTelemetryValue(GPS_ALTITUDE_INDEX,  value - 1000);
+      if (getHandWrittenValue<1>(rxBuffer, 17, value))
+        processCrossfireTelemetryValue(GPS_SATELLITES_INDEX, value);
+      break;
+
+    case BATTERY_ID:
+      if (getHandWrittenValue<2>(rxBuffer, 3, value))
+        processCrossfireTelemetryValue(BATT_VOLTAGE_INDEX, value);
+      if (getHandWrittenValue<2>(rxBuffer, 5, value))
+        processCrossfireTelemetryValue(BATT_CURRENT_INDEX, value);
+      if (getHandWrittenValue<3>(rxBuffer, 7, value))
+        processCrossfireTelemetryValue(BATT_CAPACITY_INDEX, value);
+      if (getHandWrittenValue<1>(rxBuffer, 10, value))
+        processCrossfireTelemetryValue(BATT_REMAINING_INDEX, value);
+      break;
+
+    case ATTITUDE_ID:
+      if (getHandWrittenValue<2>(rxBuffer, 3, value))
+        processCrossfireTelemetryValue(ATTITUDE_PITCH_INDEX, value/10);
+      if (getHandWrittenValue<2>(rxBuffer, 5, value))
+        processCrossfireTelemetryValue(ATTITUDE_ROLL_INDEX, value/10);
+      if (getHandWrittenValue<2>(rxBuffer, 7, value))
+        processCrossfireTelemetryValue(ATTITUDE_YAW_INDEX, value/10);
+      break;
+  }
+}
+
+// Decoding speed of the crossfireFields table against the hand-written
+// decoding it replaced, both feeding the same sensors.
+// Not run by default: --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST(Crossfire, DISABLED_telemetryFramesBenchmark)
+{
+  const int frames = 300000;
+
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  const uint8_t gps[] = { 0xEA, 0x11, GPS_ID, 0x1D, 0x0B, 0x6E, 0x40, 0x02, 0x3F, 0x5C, 0x80, 0x00, 0x64, 0x46, 0x50, 0x04, 0x4C, 0x0C, 0x00 };
+  const uint8_t battery[] = { 0xEA, 0x0A, BATTERY_ID, 0x00, 0x7B, 0x00, 0x0A, 0x00, 0x01, 0xF4, 0x4B, 0x00 };
+  const uint8_t attitude[] = { 0xEA, 0x08, ATTITUDE_ID, 0x01, 0x2C, 0xFE, 0xD4, 0x0B, 0xB8, 0x00 };
+  const uint8_t * const testFrames[] = { gps, battery, attitude };
+  const uint8_t testFramesLen[] = { sizeof(gps), sizeof(battery), sizeof(attitude) };
+
+  uint8_t * rxBuffer = getTelemetryRxBuffer(EXTERNAL_MODULE);
+
+  // register the sensors once, both loops then only update them
+  for (int i=0; i<3; i++) {
+    processCrossfireTestFrame(testFrames[i], testFramesLen[i]);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (int f=0; f<frames; f++) {
+    memcpy(rxBuffer, testFrames[f % 3], testFramesLen[f % 3]);
+    processHandWrittenFrame(rxBuffer);
+  }
+  auto handWritten = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int f=0; f<frames; f++) {
+    memcpy(rxBuffer, testFrames[f % 3], testFramesLen[f % 3]);
+    processCrossfireTelemetryFrame(EXTERNAL_MODULE);
+  }
+  auto table = std::chrono::steady_clock::now() - start;
+
+  printf("GPS, battery and attitude frames: hand-written %.1f ns/frame, table %.1f ns/frame\n",
+         std::chrono::duration<double, std::nano>(handWritten).count() / frames,
+         std::chrono::duration<double, std::nano>(table).count() / frames);
+}
 #endif
 
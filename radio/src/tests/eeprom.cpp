@@ -44,6 +44,70 @@ TEST(Storage, BackupAndRestore)
   if (memcmp(&ramBackupUncompressed, &ramBackupRestored, sizeof(ramBackupUncompressed)) != 0)
     TRACE("ERROR restore");
 }
+
+TEST(Storage, BackupDeltaAndRestore)
+{
+  MODEL_RESET();
+  g_model.limitData[10].min = -100;
+  rambackupWrite();
+
+  // only the changed block is added
+  uint16_t deltaSize = ramBackup->deltaSize;
+  g_model.limitData[10].min = -50;
+  rambackupWrite();
+  EXPECT_GT(ramBackup->deltaSize, deltaSize);
+  EXPECT_LT(ramBackup->deltaSize - deltaSize, 128);
+
+  g_model.limitData[10].min = 0;
+  EXPECT_TRUE(rambackupRestore());
+  EXPECT_EQ(-50, g_model.limitData[10].min);
+
+  // until there is no more room for the changes
+  for (int i = 0; i < 200; i++) {
+    g_model.limitData[i % MAX_OUTPUT_CHANNELS].max = i;
+    g_model.mixData[i % MAX_MIXERS].weight = i;
+    rambackupWrite();
+  }
+  EXPECT_LE(ramBackup->size + ramBackup->deltaSize, sizeof(ramBackup->data));
+
+  ModelData model = g_model;
+  EXPECT_TRUE(rambackupRestore());
+  for (int i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    EXPECT_EQ(model.limitData[i].max, g_model.limitData[i].max);
+  }
+  for (int i = 0; i < MAX_MIXERS; i++) {
+    EXPECT_EQ(model.mixData[i].weight, g_model.mixData[i].weight);
+  }
+
+  MODEL_RESET();
+  SYSTEM_RESET();
+}
+
+TEST(Storage, BackupDeltaExactCompare)
+{
+  MODEL_RESET();
+  strcpy(g_model.header.name, "Az");
+  rambackupWrite();
+
+  // same djb2 hash for the block: +1 on one char, -33 on the next one
+  uint16_t deltaSize = ramBackup->deltaSize;
+  g_model.header.name[0] = 'B';
+  g_model.header.name[1] = 'z' - 33;
+  rambackupWrite();
+  EXPECT_GT(ramBackup->deltaSize, deltaSize);
+
+  memset(g_model.header.name, 0, sizeof(g_model.header.name));
+  EXPECT_TRUE(rambackupRestore());
+  EXPECT_EQ('B', g_model.header.name[0]);
+  EXPECT_EQ('z' - 33, g_model.header.name[1]);
+
+  // nothing changed
+  deltaSize = ramBackup->deltaSize;
+  rambackupWrite();
+  EXPECT_EQ(deltaSize, ramBackup->deltaSize);
+
+  MODEL_RESET();
+}
 #endif
 
 #if defined(EEPROM) && defined(EEPROM_RLC)
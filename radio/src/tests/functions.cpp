@@ -62,6 +62,70 @@ TEST_F(SpecialFunctionsTest, FlightReset)
   EXPECT_EQ((bool)(mainRequestFlags & (1 << REQUEST_FLIGHT_RESET)), false);
 }
 
+TEST_F(SpecialFunctionsTest, FunctionAddedAfterEvaluation)
+{
+  mainRequestFlags = 0;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ((bool)(mainRequestFlags & (1 << REQUEST_SCREENSHOT)), false);
+
+  g_model.customFn[5].swtch = SWSRC_ON;
+  g_model.customFn[5].func = FUNC_SCREENSHOT;
+  storageDirty(EE_MODEL);
+
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ((bool)(mainRequestFlags & (1 << REQUEST_SCREENSHOT)), true);
+}
+
+TEST_F(SpecialFunctionsTest, SharedSwitchFunctions)
+{
+  g_model.customFn[0].swtch = SWSRC_FIRST_SWITCH;
+  g_model.customFn[0].func = FUNC_RESET;
+  g_model.customFn[0].all.val = FUNC_RESET_FLIGHT;
+  g_model.customFn[0].active = true;
+  g_model.customFn[1].swtch = SWSRC_FIRST_SWITCH;
+  g_model.customFn[1].func = FUNC_SCREENSHOT;
+
+  mainRequestFlags = 0;
+  simuSetSwitch(0, 0);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(modelFunctionsContext.groupCount, 1);
+  EXPECT_EQ(mainRequestFlags, 0);
+
+  // both functions are triggered by SA0
+  simuSetSwitch(0, -1);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ((bool)(mainRequestFlags & (1 << REQUEST_FLIGHT_RESET)), true);
+  EXPECT_EQ((bool)(mainRequestFlags & (1 << REQUEST_SCREENSHOT)), true);
+
+  // and only once while SA0 stays active
+  mainRequestFlags = 0;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(mainRequestFlags, 0);
+  EXPECT_EQ(modelFunctionsContext.activeSwitches, (MASK_CFN_TYPE)0x03);
+}
+
+#if defined(HAPTIC)
+TEST_F(SpecialFunctionsTest, RepeatDeadline)
+{
+  g_tmr10ms = 1000;
+  g_model.customFn[0].swtch = SWSRC_ON;
+  g_model.customFn[0].func = FUNC_HAPTIC;
+  CFN_PLAY_REPEAT(&g_model.customFn[0]) = 1;  // every second
+
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(modelFunctionsContext.lastFunctionTime[0], (tmr10ms_t)1000);
+
+  g_tmr10ms += 99;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(modelFunctionsContext.lastFunctionTime[0], (tmr10ms_t)1000);
+
+  g_tmr10ms += 1;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(modelFunctionsContext.lastFunctionTime[0], (tmr10ms_t)1100);
+}
+#endif
+
 #if defined(GVARS)
 TEST_F(SpecialFunctionsTest, GvarsInc)
 {
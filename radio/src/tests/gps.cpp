@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(INTERNAL_GPS)
+bool gpsNewFrameUBX(uint8_t c);
+
+static std::vector<uint8_t> ubxFrame(uint8_t msgClass, uint8_t msgId, const std::vector<uint8_t> & payload)
+{
+  std::vector<uint8_t> frame = { 0xB5, 0x62, msgClass, msgId, (uint8_t)payload.size(), (uint8_t)(payload.size() >> 8) };
+  frame.insert(frame.end(), payload.begin(), payload.end());
+  uint8_t ckA = 0, ckB = 0;
+  for (size_t i = 2; i < frame.size(); i++) {
+    ckA += frame[i];
+    ckB += ckA;
+  }
+  frame.push_back(ckA);
+  frame.push_back(ckB);
+  return frame;
+}
+
+static void ubxPutI4(std::vector<uint8_t> & payload, int offset, int32_t value)
+{
+  for (int i = 0; i < 4; i++) {
+    payload[offset + i] = (uint32_t)value >> (8 * i);
+  }
+}
+
+// 3D fix, 12 satellites, 45.5 -73.6, 123.456m, 1.234m/s, 18.05deg
+static std::vector<uint8_t> ubxNavPvt()
+{
+  std::vector<uint8_t> payload(92, 0);
+  payload[20] = 3;      // fixType
+  payload[21] = 0x01;   // gnssFixOK
+  payload[23] = 12;     // numSV
+  ubxPutI4(payload, 24, -736000000);
+  ubxPutI4(payload, 28, 455000000);
+  ubxPutI4(payload, 36, 123456);
+  ubxPutI4(payload, 60, 12340);
+  ubxPutI4(payload, 64, 1805000);
+  return ubxFrame(0x01, 0x07, payload);
+}
+
+// returns the number of frames decoded
+static int ubxParse(const std::vector<uint8_t> & bytes)
+{
+  int frames = 0;
+  for (auto c: bytes) {
+    if (gpsNewFrameUBX(c))
+      frames++;
+  }
+  return frames;
+}
+
+TEST(Gps, ubxNavPvt)
+{
+  memclear(&gpsData, sizeof(gpsData));
+
+  EXPECT_EQ(1, ubxParse(ubxNavPvt()));
+  EXPECT_EQ(1u, gpsData.packetCount);
+  EXPECT_EQ(0u, gpsData.errorCount);
+  EXPECT_EQ(1, gpsData.fix);
+  EXPECT_EQ(12, gpsData.numSat);
+  EXPECT_EQ(45500000, gpsData.latitude);
+  EXPECT_EQ(-73600000, gpsData.longitude);
+  EXPECT_EQ(123, gpsData.altitude);
+  EXPECT_EQ(1234, gpsData.speed);
+  EXPECT_EQ(180, gpsData.groundCourse);
+
+  // NAV-DOP: HDOP only
+  std::vector<uint8_t> dop(18, 0);
+  dop[12] = 0x96;
+  EXPECT_EQ(0, ubxParse(ubxFrame(0x01, 0x04, dop)));
+  EXPECT_EQ(150, gpsData.hdop);
+  EXPECT_EQ(2u, gpsData.packetCount);
+}
+
+TEST(Gps, ubxBadChecksum)
+{
+  memclear(&gpsData, sizeof(gpsData));
+
+  auto frame = ubxNavPvt();
+  frame[frame.size() - 2] ^= 0x01;
+  EXPECT_EQ(0, ubxParse(frame));
+
+  frame = ubxNavPvt();
+  frame[frame.size() - 1] ^= 0x01;
+  EXPECT_EQ(0, ubxParse(frame));
+
+  // corrupted payload
+  frame = ubxNavPvt();
+  frame[6 + 28] ^= 0x01;
+  EXPECT_EQ(0, ubxParse(frame));
+
+  EXPECT_EQ(0u, gpsData.packetCount);
+  EXPECT_EQ(3u, gpsData.errorCount);
+  EXPECT_EQ(0, gpsData.latitude);
+  EXPECT_EQ(1, ubxParse(ubxNavPvt()));
+}
+
+TEST(Gps, ubxLength)
+{
+  memclear(&gpsData, sizeof(gpsData));
+
+  // NAV-PVT of an older protocol version, checksum OK but not decoded
+  EXPECT_EQ(0, ubxParse(ubxFrame(0x01, 0x07, std::vector<uint8_t>(84, 0x55))));
+  EXPECT_EQ(1u, gpsData.packetCount);
+  EXPECT_EQ(0, gpsData.latitude);
+
+  // longer than the payload buffer, still checksummed
+  EXPECT_EQ(0, ubxParse(ubxFrame(0x01, 0x07, std::vector<uint8_t>(200, 0x55))));
+  EXPECT_EQ(2u, gpsData.packetCount);
+  EXPECT_EQ(0, gpsData.latitude);
+
+  // corrupted length: the next frame is not swallowed
+  std::vector<uint8_t> bytes = { 0xB5, 0x62, 0x01, 0x07, 0xFF, 0xFF };
+  auto frame = ubxNavPvt();
+  bytes.insert(bytes.end(), frame.begin(), frame.end());
+  EXPECT_EQ(1, ubxParse(bytes));
+  EXPECT_EQ(3u, gpsData.packetCount);
+  EXPECT_EQ(45500000, gpsData.latitude);
+}
+
+TEST(Gps, ubxSyncRecovery)
+{
+  memclear(&gpsData, sizeof(gpsData));
+
+  // truncated frame, which swallows the beginning of the next one
+  auto frame = ubxNavPvt();
+  std::vector<uint8_t> bytes(frame.begin(), frame.begin() + 50);
+  bytes.insert(bytes.end(), frame.begin(), frame.end());
+  // NMEA text and a lone sync char between frames
+  const char nmea[] = "$GPGGA,,,,,,0,00,,,M,,M,,*66\r\n";
+  bytes.insert(bytes.end(), nmea, nmea + sizeof(nmea) - 1);
+  bytes.push_back(0xB5);
+  bytes.insert(bytes.end(), frame.begin(), frame.end());
+
+  EXPECT_EQ(1, ubxParse(bytes));
+  EXPECT_EQ(1u, gpsData.packetCount);
+  EXPECT_EQ(1u, gpsData.errorCount);
+  EXPECT_EQ(45500000, gpsData.latitude);
+
+  // back in sync
+  EXPECT_EQ(1, ubxParse(ubxNavPvt()));
+  EXPECT_EQ(2u, gpsData.packetCount);
+}
+
+static uint32_t gpsTestBaudrate;
+static int gpsTestBaudrateChanges;
+static int gpsTestBytesSent;
+static std::vector<uint8_t> gpsTestRx;
+
+static void gpsTestSendByte(void *, uint8_t)
+{
+  gpsTestBytesSent++;
+}
+
+static int gpsTestGetByte(void *, uint8_t * data)
+{
+  if (gpsTestRx.empty())
+    return 0;
+  *data = gpsTestRx.front();
+  gpsTestRx.erase(gpsTestRx.begin());
+  return 1;
+}
+
+static void gpsTestSetBaudrate(void *, uint32_t baudrate)
+{
+  gpsTestBaudrate = baudrate;
+  gpsTestBaudrateChanges++;
+}
+
+TEST(Gps, baudrateDetectionStops)
+{
+  etx_serial_driver_t drv;
+  memclear(&drv, sizeof(drv));
+  drv.sendByte = gpsTestSendByte;
+  drv.getByte = gpsTestGetByte;
+  drv.setBaudrate = gpsTestSetBaudrate;
+
+  gpsTestBaudrate = GPS_USART_BAUDRATE;
+  gpsTestBaudrateChanges = 0;
+  gpsTestRx.clear();
+  gpsSetSerialDriver(nullptr, &drv);
+
+  // one minute without any receiver
+  for (int i = 0; i < 6000; i++) {
+    g_tmr10ms++;
+    gpsWakeup();
+  }
+  EXPECT_EQ(4, gpsTestBaudrateChanges);
+  EXPECT_EQ((uint32_t)GPS_USART_BAUDRATE, gpsTestBaudrate);
+
+  // a receiver answering later is still configured
+  gpsTestBytesSent = 0;
+  gpsTestRx = ubxNavPvt();
+  for (int i = 0; i < 100; i++) {
+    g_tmr10ms++;
+    gpsWakeup();
+  }
+  EXPECT_GT(gpsTestBytesSent, 0);
+
+  gpsSetSerialDriver(nullptr, nullptr);
+}
+#endif
@@ -25,6 +25,10 @@
 #define SWAP_DEFINED
 #include "opentx.h"
 #include "location.h"
+#include "bitmap_cache.h"
+#include "native_bitmap.h"
+
+#include <fstream>
 
 #if defined(COLORLCD)
 
@@ -263,6 +267,161 @@ TEST(Lcd_colorlcd, bitmap)
   EXPECT_TRUE(checkScreenshot_colorlcd(&dc, "bitmap"));
 }
 
+TEST(Lcd_colorlcd, bitmapCache)
+{
+  BitmapCache cache;
+  const char * path = TESTS_PATH "/opentx.png";
+
+  SharedBitmap bmp = cache.get(path);
+  ASSERT_TRUE(bmp != nullptr);
+  uint32_t size = bmp->getDataSize();
+  EXPECT_EQ(cache.getMisses(), 1u);
+  EXPECT_EQ(cache.getUsage(), size);
+
+  // hit
+  EXPECT_EQ(cache.get(path), bmp);
+  EXPECT_EQ(cache.getHits(), 1u);
+
+  // the pre-scaled variant is another entry
+  SharedBitmap scaled = cache.get(path, 32, 16);
+  ASSERT_TRUE(scaled != nullptr);
+  EXPECT_NE(scaled, bmp);
+  EXPECT_EQ(scaled->width(), 32);
+  EXPECT_EQ(scaled->height(), 16);
+  EXPECT_EQ(cache.getUsage(), size + scaled->getDataSize());
+
+  // invalidation drops both variants, bitmaps in use stay valid and counted
+  cache.invalidate(path);
+  SharedBitmap reloaded = cache.get(path);
+  ASSERT_TRUE(reloaded != nullptr);
+  EXPECT_NE(reloaded, bmp);
+  EXPECT_EQ(cache.getMisses(), 3u);
+  EXPECT_EQ(cache.getUsage(), 2 * size + scaled->getDataSize());
+  bmp.reset();
+  scaled.reset();
+  EXPECT_EQ(cache.getUsage(), size);
+
+  // eviction only drops the entries which are not in use
+  cache.setBudget(0);
+  EXPECT_TRUE(cache.isFull());
+  EXPECT_EQ(cache.get(path), reloaded);
+  reloaded.reset();
+  EXPECT_FALSE(cache.isFull());
+  EXPECT_EQ(cache.getUsage(), 0u);
+
+  // missing file
+  EXPECT_TRUE(cache.get(TESTS_PATH "/missing.png") == nullptr);
+}
+
+static void copyTestFile(const char * from, const std::string & to)
+{
+  std::ifstream src(from, std::ios::binary);
+  std::ofstream dst(to, std::ios::binary);
+  dst << src.rdbuf();
+}
+
+TEST(Lcd_colorlcd, bitmapCacheFilesChanged)
+{
+  BitmapCache cache;
+  const std::string path = TESTS_BUILD_PATH "/cached.png";
+
+  copyTestFile(TESTS_PATH "/opentx.png", path);
+  SharedBitmap bmp = cache.get(path.c_str());
+  ASSERT_TRUE(bmp != nullptr);
+
+  // the file is not checked until a writer reports changes
+  copyTestFile(TESTS_PATH "/bitmap_480x272.png", path);
+  EXPECT_EQ(cache.get(path.c_str()), bmp);
+
+  cache.filesChanged();
+  SharedBitmap reloaded = cache.get(path.c_str());
+  ASSERT_TRUE(reloaded != nullptr);
+  EXPECT_NE(reloaded, bmp);
+  EXPECT_EQ(reloaded->width(), 480);
+  EXPECT_EQ(cache.getMisses(), 2u);
+
+  // unchanged files are kept
+  cache.filesChanged();
+  EXPECT_EQ(cache.get(path.c_str()), reloaded);
+  EXPECT_EQ(cache.getMisses(), 2u);
+
+  remove(path.c_str());
+}
+
+static void writeNativeBitmap(const std::string & path, uint32_t sourceTime)
+{
+  NativeBitmapHeader hdr;
+  memcpy(hdr.magic, NATIVE_BITMAP_MAGIC, sizeof(hdr.magic));
+  hdr.version = NATIVE_BITMAP_VERSION;
+  hdr.width = 2;
+  hdr.height = 1;
+  hdr.format = NATIVE_BITMAP_RGB565;
+  hdr.compression = NATIVE_BITMAP_RAW;
+  hdr.reserved = 0;
+  hdr.length = 2 * sizeof(pixel_t);
+  hdr.sourceTime = sourceTime;
+
+  const pixel_t pixels[] = { 0x1234, 0xABCD };
+  std::ofstream file(path, std::ios::binary);
+  file.write((const char *)&hdr, sizeof(hdr));
+  file.write((const char *)pixels, sizeof(pixels));
+}
+
+TEST(Lcd_colorlcd, nativeBitmap)
+{
+  const std::string native = TESTS_BUILD_PATH "/native.ebm";
+  writeNativeBitmap(native, 0);
+  std::unique_ptr<BitmapBuffer> bmp(BitmapBuffer::loadBitmap(native.c_str()));
+  ASSERT_TRUE(bmp != nullptr);
+  EXPECT_EQ(bmp->width(), 2);
+  EXPECT_EQ(bmp->height(), 1);
+  EXPECT_EQ(*bmp->getPixelPtr(0, 0), 0x1234);
+  EXPECT_EQ(*bmp->getPixelPtr(1, 0), 0xABCD);
+
+  // sidecar of an image, used as long as the image keeps the same date
+  const std::string image = TESTS_BUILD_PATH "/native.png";
+  {
+    std::ifstream src(TESTS_PATH "/opentx.png", std::ios::binary);
+    std::ofstream dst(image, std::ios::binary);
+    dst << src.rdbuf();
+  }
+  std::unique_ptr<BitmapBuffer> decoded(BitmapBuffer::loadBitmap(TESTS_PATH "/opentx.png"));
+  ASSERT_TRUE(decoded != nullptr);
+
+  FILINFO info;
+  ASSERT_EQ(f_stat(image.c_str(), &info), FR_OK);
+  writeNativeBitmap(image + NATIVE_BITMAP_EXT, (uint32_t)info.fdate << 16 | info.ftime);
+  bmp.reset(BitmapBuffer::loadBitmap(image.c_str()));
+  ASSERT_TRUE(bmp != nullptr);
+  EXPECT_EQ(bmp->width(), 2);
+
+  // newer or older image
+  writeNativeBitmap(image + NATIVE_BITMAP_EXT, 0xFFFFFFFF);
+  bmp.reset(BitmapBuffer::loadBitmap(image.c_str()));
+  ASSERT_TRUE(bmp != nullptr);
+  EXPECT_EQ(bmp->width(), decoded->width());
+
+  writeNativeBitmap(image + NATIVE_BITMAP_EXT, 0);
+  bmp.reset(BitmapBuffer::loadBitmap(image.c_str()));
+  ASSERT_TRUE(bmp != nullptr);
+  EXPECT_EQ(bmp->width(), decoded->width());
+
+  // invalid sidecar
+  std::ofstream(image + NATIVE_BITMAP_EXT, std::ios::binary) << "EBX";
+  bmp.reset(BitmapBuffer::loadBitmap(image.c_str()));
+  ASSERT_TRUE(bmp != nullptr);
+  EXPECT_EQ(bmp->width(), decoded->width());
+
+  // orphaned sidecar of a deleted image
+  writeNativeBitmap(image + NATIVE_BITMAP_EXT, (uint32_t)info.fdate << 16 | info.ftime);
+  remove(image.c_str());
+  bmp.reset(BitmapBuffer::loadBitmap(image.c_str()));
+  EXPECT_TRUE(bmp == nullptr);
+
+  remove(native.c_str());
+  remove((image + NATIVE_BITMAP_EXT).c_str());
+}
+
 TEST(Lcd_colorlcd, masks)
 {
   BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
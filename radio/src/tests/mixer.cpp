@@ -500,6 +500,84 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, SmoothCurveEdit)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.curves[0].smooth = 1;
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 50*i;
+  }
+  EXPECT_EQ(applyCustomCurve(-1024, 0), -1024);
+  EXPECT_EQ(applyCustomCurve(0, 0), 0);
+  EXPECT_EQ(applyCustomCurve(1024, 0), 1024);
+
+  // points edited in place must be taken into account
+  g_model.points[2] = 50;
+  EXPECT_EQ(applyCustomCurve(0, 0), 512);
+  g_model.points[4] = 0;
+  EXPECT_EQ(applyCustomCurve(1024, 0), 0);
+}
+
+TEST(Curves, CustomCurveUnorderedX)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.curves[0].type = CURVE_TYPE_CUSTOM;
+  loadCurves();
+  for (int8_t i=-2; i<=2; i++) {
+    g_model.points[2+i] = 50*i;
+  }
+  // X points not in increasing order: the first matching segment is used
+  g_model.points[5] = 50;
+  g_model.points[6] = -50;
+  g_model.points[7] = 0;
+  EXPECT_EQ(applyCustomCurve(-256, 0), -768);
+  EXPECT_EQ(applyCustomCurve(0, 0), -682);
+  EXPECT_EQ(applyCustomCurve(768, 0), 896);
+
+  g_model.curves[0].smooth = 1;
+  EXPECT_EQ(applyCustomCurve(-256, 0), -705);
+  EXPECT_EQ(applyCustomCurve(0, 0), -607);
+  EXPECT_EQ(applyCustomCurve(768, 0), 908);
+}
+
+// expo() as computed before the calc100to256() table
+static int expoReference(int x, int k)
+{
+  if (k == 0)
+    return x;
+  bool neg = (x < 0);
+  if (neg)
+    x = -x;
+  if (x > RESX)
+    x = RESX;
+  int y;
+  if (k < 0) {
+    uint32_t v = RESX - x;
+    uint32_t k256 = calc100to256(-k);
+    y = RESX - (int)(((((v * v * k256) >> 8) * v >> 12) + (256 - k256) * v + 128) >> 8);
+  }
+  else {
+    uint32_t k256 = calc100to256(k);
+    y = (int)(((((x * x * k256) >> 8) * x >> 12) + (256 - k256) * x + 128) >> 8);
+  }
+  return neg ? -y : y;
+}
+
+TEST(Curves, Expo)
+{
+  for (int k = -100; k <= 100; k++) {
+    for (int x = -RESX - 10; x <= RESX + 10; x++) {
+      ASSERT_EQ(expo(x, k), expoReference(x, k)) << "x=" << x << " k=" << k;
+    }
+  }
+}
+
 
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
@@ -132,6 +132,40 @@ TEST(evalLogicalSwitches, playFile)
   EXPECT_EQ(isAudioFileReferenced((LOGICAL_SWITCH_AUDIO_CATEGORY << 24) + (31 << 16) + AUDIO_EVENT_ON, filename), true);
   EXPECT_EQ(isAudioFileReferenced((LOGICAL_SWITCH_AUDIO_CATEGORY << 24) + (32 << 16) + AUDIO_EVENT_ON, filename), false);
 
+#undef MODELNAME
+}
+
+TEST(Audio, referenceModelAudioFile)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  setModelDefaults();
+
+  extern BitField<(MAX_LOGICAL_SWITCHES * 2/*on, off*/)> sdAvailableLogicalSwitchAudioFiles;
+  sdAvailableLogicalSwitchAudioFiles.reset();
+  char filename[AUDIO_FILENAME_MAXLEN+1];
+
+#define MODELNAME TR_MODEL "01"
+
+  EXPECT_TRUE(referenceModelAudioFile("SA-up.wav"));
+  EXPECT_TRUE(isAudioFileReferenced((SWITCH_AUDIO_CATEGORY << 24) + (0 << 16), filename));
+  EXPECT_STREQ(filename, "/SOUNDS/en/" MODELNAME "/SA-up.wav");
+
+  EXPECT_TRUE(referenceModelAudioFile("sb-DOWN.WAV"));
+  EXPECT_TRUE(isAudioFileReferenced((SWITCH_AUDIO_CATEGORY << 24) + (5 << 16), filename));
+  EXPECT_STREQ(filename, "/SOUNDS/en/" MODELNAME "/SB-down.wav");
+
+  EXPECT_TRUE(referenceModelAudioFile("L32-on.wav"));
+  EXPECT_TRUE(isAudioFileReferenced((LOGICAL_SWITCH_AUDIO_CATEGORY << 24) + (31 << 16) + AUDIO_EVENT_ON, filename));
+  EXPECT_STREQ(filename, "/SOUNDS/en/" MODELNAME "/L32-on.wav");
+  EXPECT_FALSE(isAudioFileReferenced((LOGICAL_SWITCH_AUDIO_CATEGORY << 24) + (31 << 16) + AUDIO_EVENT_OFF, filename));
+
+  EXPECT_FALSE(referenceModelAudioFile("L0-on.wav"));
+  EXPECT_FALSE(referenceModelAudioFile("L01-on.wav"));
+  EXPECT_FALSE(referenceModelAudioFile("L1-on.txt"));
+  EXPECT_FALSE(referenceModelAudioFile("SA-on.wav"));
+  EXPECT_FALSE(referenceModelAudioFile("name.wav"));
+
 #undef MODELNAME
 }
 #endif
@@ -30,6 +30,14 @@
   #define FILE FIL
 #endif
 
+#if defined(USE_FATFS) && defined(COLORLCD)
+  // cached images are checked again after a file is written
+  void bitmapCacheFilesChanged(void);
+  #define FILES_CHANGED()  bitmapCacheFilesChanged()
+#else
+  #define FILES_CHANGED()
+#endif
+
 #if !defined(lua_checkmode)
 
 /*
@@ -191,7 +199,10 @@ static int aux_close (lua_State *L) {
 
 static int io_close (lua_State *L) {
 #if defined(USE_FATFS)
-  f_close(tofile(L));
+  FIL * f = tofile(L);
+  if (f->flag & FA_WRITE)
+    FILES_CHANGED();
+  f_close(f);
   return 0;
 #else
   if (lua_isnone(L, 1))  /* no argument? */
@@ -252,6 +263,8 @@ static int io_open (lua_State *L) {
     mode = FA_WRITE | FA_OPEN_ALWAYS;       // always open file (create it if necessary) 
   FRESULT result = f_open(&p->f, filename, mode);
   if (result == FR_OK) {
+    if (mode & FA_WRITE)
+      FILES_CHANGED();
     if (*md == 'a')
       f_lseek(&p->f, f_size(&p->f));   // seek to the end of the file
     return 1;
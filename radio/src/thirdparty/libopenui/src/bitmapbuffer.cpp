@@ -24,6 +24,7 @@
 #include "libopenui_helpers.h"
 #include "libopenui_file.h"
 #include "font.h"
+#include "native_bitmap.h"
 
 #include "lvgl/src/draw/sw/lv_draw_sw.h"
 
@@ -1254,6 +1255,13 @@ BitmapBuffer * BitmapBuffer::loadBitmap(const char * filename, BitmapFormats fmt
 {
   //TRACE("  BitmapBuffer::loadBitmap(%s)", filename);
   const char * ext = getFileExtension(filename);
+  if (ext && !strcasecmp(ext, NATIVE_BITMAP_EXT))
+    return load_native(filename, fmt);
+
+  BitmapBuffer * bitmap = load_native_sidecar(filename, fmt);
+  if (bitmap)
+    return bitmap;
+
   if (ext && !strcmp(ext, ".bmp"))
     return load_bmp(filename);
   else
@@ -1822,3 +1830,109 @@ LZ4Mask::~LZ4Mask()
 {
   free(data);
 }
+
+BitmapBuffer * BitmapBuffer::load_native(const char * filename, BitmapFormats fmt)
+{
+  NativeBitmapHeader hdr;
+  if (!open_native(filename, fmt, hdr)) {
+    return nullptr;
+  }
+  return read_native(filename, hdr);
+}
+
+// Opens 'filename' in imgFile and reads its header
+bool BitmapBuffer::open_native(const char * filename, BitmapFormats fmt, NativeBitmapHeader & hdr)
+{
+  FRESULT result = f_open(&imgFile, filename, FA_OPEN_EXISTING | FA_READ);
+  if (result != FR_OK) {
+    return false;
+  }
+
+  UINT read;
+  result = f_read(&imgFile, &hdr, sizeof(hdr), &read);
+  if (result != FR_OK || read != sizeof(hdr) ||
+      memcmp(hdr.magic, NATIVE_BITMAP_MAGIC, sizeof(hdr.magic)) != 0 ||
+      hdr.version != NATIVE_BITMAP_VERSION ||
+      (hdr.format != BMP_RGB565 && hdr.format != BMP_ARGB4444) ||
+      (fmt != BMP_INVALID && hdr.format != fmt) ||
+      f_size(&imgFile) < sizeof(hdr) + hdr.length) {
+    f_close(&imgFile);
+    return false;
+  }
+
+  uint32_t size = hdr.width * hdr.height * sizeof(pixel_t);
+  if (hdr.compression == NATIVE_BITMAP_RAW ? hdr.length != size
+                                           : hdr.compression != NATIVE_BITMAP_LZ4) {
+    f_close(&imgFile);
+    return false;
+  }
+
+  return true;
+}
+
+// Reads the pixels following the header, and closes imgFile
+BitmapBuffer * BitmapBuffer::read_native(const char * filename, const NativeBitmapHeader & hdr)
+{
+  BitmapBuffer * bmp = new BitmapBuffer(hdr.format, hdr.width, hdr.height);
+  if (bmp == nullptr || bmp->getData() == nullptr) {
+    TRACE("load_native(%s): malloc failed", filename);
+    delete bmp;
+    f_close(&imgFile);
+    return nullptr;
+  }
+
+  UINT read;
+  uint32_t size = hdr.width * hdr.height * sizeof(pixel_t);
+  if (hdr.compression == NATIVE_BITMAP_RAW) {
+    FRESULT result = f_read(&imgFile, bmp->getData(), size, &read);
+    if (result != FR_OK || read != size) {
+      delete bmp;
+      bmp = nullptr;
+    }
+  }
+  else {
+    char * compressed = (char *)malloc(hdr.length);
+    if (compressed == nullptr ||
+        f_read(&imgFile, compressed, hdr.length, &read) != FR_OK ||
+        read != hdr.length ||
+        LZ4_decompress_safe(compressed, (char *)bmp->getData(), hdr.length,
+                            size) != (int)size) {
+      delete bmp;
+      bmp = nullptr;
+    }
+    free(compressed);
+  }
+
+  f_close(&imgFile);
+  return bmp;
+}
+
+// Use "<filename>.ebm" if present and made from the current image: the
+// sidecar is probed by opening it, the image is only checked when it exists.
+// Any other image date (an older file copied over it) or a missing image
+// means the sidecar is stale.
+BitmapBuffer * BitmapBuffer::load_native_sidecar(const char * filename, BitmapFormats fmt)
+{
+  char path[FF_MAX_LFN + 1];
+  size_t len = strlen(filename);
+  if (len + sizeof(NATIVE_BITMAP_EXT) > sizeof(path)) {
+    return nullptr;
+  }
+  memcpy(path, filename, len);
+  memcpy(path + len, NATIVE_BITMAP_EXT, sizeof(NATIVE_BITMAP_EXT));
+
+  NativeBitmapHeader hdr;
+  if (!open_native(path, fmt, hdr)) {
+    return nullptr;
+  }
+
+  FILINFO source;
+  if (f_stat(filename, &source) != FR_OK ||
+      hdr.sourceTime != ((uint32_t)source.fdate << 16 | source.ftime)) {
+    TRACE("load_native_sidecar(%s): outdated", path);
+    f_close(&imgFile);
+    return nullptr;
+  }
+
+  return read_native(path, hdr);
+}
@@ -59,6 +59,8 @@ typedef _lv_draw_ctx_t lv_draw_ctx_t;
 struct _lv_obj_t;
 typedef _lv_obj_t lv_obj_t;
 
+struct NativeBitmapHeader;
+
 template<class T>
 class BitmapBufferBase
 {
@@ -360,6 +362,10 @@ class BitmapBuffer: public BitmapBufferBase<pixel_t>
 
   protected:
     static BitmapBuffer * load_bmp(const char * filename);
+    static BitmapBuffer * load_native(const char * filename, BitmapFormats fmt = BMP_INVALID);
+    static BitmapBuffer * load_native_sidecar(const char * filename, BitmapFormats fmt);
+    static bool open_native(const char * filename, BitmapFormats fmt, NativeBitmapHeader & hdr);
+    static BitmapBuffer * read_native(const char * filename, const NativeBitmapHeader & hdr);
     static BitmapBuffer * load_stb(const char * filename, BitmapFormats fmt = BMP_INVALID);
     static BitmapBuffer * load_stb_buffer(const uint8_t * buffer, int len);
     static BitmapBuffer * convert_stb_bitmap(uint8_t * img, int w, int h, int n,
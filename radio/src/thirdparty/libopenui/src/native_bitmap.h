@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   libopenui - https://github.com/opentx/libopenui
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Pre-decoded bitmap container ("native bitmap")
+//
+// Pixels are stored exactly as in BitmapBuffer memory (16 bit little
+// endian RGB565 or ARGB4444), either raw or LZ4 compressed, so that
+// loading boils down to a single read (+ LZ4 decode).
+//
+// Companion writes them next to the source image when syncing the SD card
+// ("background.png" -> "background.png.ebm"), with the modification time of
+// the source image. The firmware uses it instead of decoding the source image
+// as long as the source exists and still has this modification time.
+
+#define NATIVE_BITMAP_EXT      ".ebm"
+#define NATIVE_BITMAP_MAGIC    "EBM"
+#define NATIVE_BITMAP_VERSION  2
+
+enum NativeBitmapFormat {
+  NATIVE_BITMAP_RGB565 = 1,    // == BMP_RGB565
+  NATIVE_BITMAP_ARGB4444 = 2,  // == BMP_ARGB4444
+};
+
+enum NativeBitmapCompression {
+  NATIVE_BITMAP_RAW = 0,
+  NATIVE_BITMAP_LZ4 = 1,
+};
+
+struct NativeBitmapHeader {
+  char magic[3];
+  uint8_t version;
+  uint16_t width;
+  uint16_t height;
+  uint8_t format;       // NativeBitmapFormat
+  uint8_t compression;  // NativeBitmapCompression
+  uint16_t reserved;
+  uint32_t length;      // payload length in bytes
+  uint32_t sourceTime;  // FAT date << 16 | FAT time of the source image
+} __attribute__((packed));
+
+static_assert(sizeof(NativeBitmapHeader) == 20, "NativeBitmapHeader size");
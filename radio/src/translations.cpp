@@ -188,6 +188,7 @@ const char STR_SF_VOLUME[] = TR_SF_VOLUME;
 const char STR_SF_RACING_MODE[] = TR_SF_RACING_MODE;
 const char STR_SF_SAFETY[] = TR_SF_SAFETY;
 const char STR_SF_SET_SCREEN[] = TR_SF_SET_SCREEN;
+const char STR_SF_SCREEN_RECORD[] = TR_SF_SCREEN_RECORD;
 const char STR_SF_SCREENSHOT[] = TR_SF_SCREENSHOT;
 const char STR_SF_TEST[] = TR_SF_TEST;
 const char STR_TRIMS[] = TR_TRIMS;
@@ -269,7 +270,9 @@ const char STR_NODATA[] = TR_NODATA;
 const char STR_US[] = TR_US;
 const char STR_HZ[]  = TR_HZ;
 const char STR_TMIXMAXMS[] = TR_TMIXMAXMS;
+const char STR_MIXER_LATE[] = TR_MIXER_LATE;
 const char STR_FREE_STACK[] = TR_FREE_STACK;
+const char STR_CPU_LOAD[] = TR_CPU_LOAD;
 const char STR_INT_GPS_LABEL[]  = TR_INT_GPS_LABEL;
 const char STR_HEARTBEAT_LABEL[]  = TR_HEARTBEAT_LABEL;
 const char STR_LUA_SCRIPTS_LABEL[]  = TR_LUA_SCRIPTS_LABEL;
@@ -725,6 +728,7 @@ const char STR_MENU_OTHER[] = TR_MENU_OTHER;
 const char STR_MENU_INVERT[] = TR_MENU_INVERT;
 const char STR_AUDIO_MUTE[] = TR_AUDIO_MUTE;
 const char STR_JITTER_FILTER[] = TR_JITTER_FILTER;
+const char STR_MIXER_DEFER[] = TR_MIXER_DEFER;
 const char STR_DEAD_ZONE[] = TR_DEAD_ZONE;
 const char STR_RTC_CHECK[]  = TR_RTC_CHECK;
 const char STR_EXIT[] = TR_EXIT;
@@ -908,6 +912,7 @@ const char STR_BACKUP_MODEL[] = TR_BACKUP_MODEL;
 const char STR_RESTORE_MODEL[] = TR_RESTORE_MODEL;
 const char STR_DELETE_ERROR[] = TR_DELETE_ERROR;
 const char STR_SDCARD_ERROR[] = TR_SDCARD_ERROR;
+const char STR_CANCEL[] = TR_CANCEL;
 #define STR_SDCARD TR_SDCARD
 #define STR_NO_FILES_ON_SD TR_NO_FILES_ON_SD
 #define STR_EDIT TR_EDIT
@@ -996,7 +1001,6 @@ const char STR_THEME_FOCUS[] = TR_THEME_FOCUS;
 const char STR_AUTHOR[] = TR_AUTHOR;
 const char STR_DESCRIPTION[] = TR_DESCRIPTION;
 const char STR_SAVE[] = TR_SAVE;
-const char STR_CANCEL[] = TR_CANCEL;
 const char STR_EDIT_THEME[] = TR_EDIT_THEME;
 const char STR_DETAILS[] = TR_DETAILS;
 const char STR_THEME_EDITOR[] = TR_THEME_EDITOR;
@@ -307,6 +307,7 @@ extern const char STR_SF_RESET[];
 extern const char STR_SF_SET_TIMER[];
 extern const char STR_SF_SAFETY[];
 extern const char STR_SF_SET_SCREEN[];
+extern const char STR_SF_SCREEN_RECORD[];
 extern const char STR_SF_SWITCH[];
 extern const char STR_SF_TRAINER[];
 extern const char STR_SF_VARIO[];
@@ -445,7 +446,9 @@ extern const char STR_NODATA[];
 extern const char STR_US[];
 extern const char STR_HZ[];
 extern const char STR_TMIXMAXMS[];
+extern const char STR_MIXER_LATE[];
 extern const char STR_FREE_STACK[];
+extern const char STR_CPU_LOAD[];
 extern const char STR_INT_GPS_LABEL[];
 extern const char STR_HEARTBEAT_LABEL[];
 extern const char STR_LUA_SCRIPTS_LABEL[];
@@ -687,6 +690,7 @@ extern const char STR_BACKUP_MODEL[];
 extern const char STR_RESTORE_MODEL[];
 extern const char STR_DELETE_ERROR[];
 extern const char STR_SDCARD_ERROR[];
+extern const char STR_CANCEL[];
 extern const char STR_NO_SDCARD[];
 extern const char STR_SDCARD_FULL[];
 extern const char STR_INCOMPATIBLE[];
@@ -1119,6 +1123,7 @@ extern const char STR_MENU_OTHER[];
 extern const char STR_MENU_INVERT[];
 extern const char STR_AUDIO_MUTE[];
 extern const char STR_JITTER_FILTER[];
+extern const char STR_MIXER_DEFER[];
 extern const char STR_DEAD_ZONE[];
 extern const char STR_RTC_CHECK[];
 extern const char STR_SPORT_UPDATE_POWER_MODE[];
@@ -1182,7 +1187,6 @@ extern const char STR_THEME_FOCUS[];
 extern const char STR_AUTHOR[];
 extern const char STR_DESCRIPTION[];
 extern const char STR_SAVE[];
-extern const char STR_CANCEL[];
 extern const char STR_EDIT_THEME[];
 extern const char STR_DETAILS[];
 extern const char STR_THEME_EDITOR[];
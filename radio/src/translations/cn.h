@@ -112,6 +112,7 @@
 #define TR_SF_RACING_MODE              "竞速模式"
 #define TR_SF_DISABLE_TOUCH            "禁用触摸"
 #define TR_SF_SET_SCREEN               "选择主屏"
+#define TR_SF_SCREEN_RECORD            "录屏"
 #define TR_SF_RESERVE                  "[保留]"
 
 #define TR_FSW_RESET_TELEM             "回传参数"
@@ -399,7 +400,9 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_MIXER_LATE                  "Mix late"
 #define TR_FREE_STACK                  "Free stack"
+#define TR_CPU_LOAD                    "CPU load"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua scripts"
@@ -1101,6 +1104,7 @@
 #define TR_MENU_INVERT                 "反向"
 #define TR_AUDIO_MUTE                  TR("自动静音","音频停播时自动静音")
 #define TR_JITTER_FILTER               "模拟输入滤波"
+#define TR_MIXER_DEFER                 TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE                   "死区"
 #define TR_RTC_CHECK                   TR("检查时间电池", "检查时间驱动电池电压")
 #define TR_AUTH_FAILURE                "验证失败"
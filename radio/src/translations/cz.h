@@ -126,6 +126,7 @@
 #define TR_SF_RACING_MODE              "Závodní režim"
 #define TR_SF_DISABLE_TOUCH            "Deaktivace dotyku"
 #define TR_SF_SET_SCREEN               "Vybrat hlavní obrazovku"
+#define TR_SF_SCREEN_RECORD            "Nahrávat obrazovku"
 
 #define TR_FSW_RESET_TELEM             TR("Telm","Telemetrie")
 
@@ -414,7 +415,9 @@
 #define TR_HZ                          "Hz"
 
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_MIXER_LATE                  "Mix pozdě"
 #define TR_FREE_STACK                  "Free stack"
+#define TR_CPU_LOAD                    "CPU load"
 #define TR_INT_GPS_LABEL               "Vnitřní GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua skripty"
@@ -1117,6 +1120,7 @@
 #define TR_MENU_INVERT                 "Invertovat"
 #define TR_AUDIO_MUTE                  TR("Ztlumení zvuku","Ztlumení, pokud není slyšet zvuk")
 #define TR_JITTER_FILTER               "ADC Filtr"
+#define TR_MIXER_DEFER                 TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE                   "Dead zone"
 #define TR_RTC_CHECK                   TR("Kontr RTC", "Hlídat RTC napětí")
 #define TR_AUTH_FAILURE                "Auth-selhala"
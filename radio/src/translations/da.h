@@ -124,6 +124,7 @@
 #define TR_SF_RACING_MODE              "Ræs tilstand"
 #define TR_SF_DISABLE_TOUCH            "Ikke berøringsaktiv"
 #define TR_SF_SET_SCREEN               "Vælg hoved skærm"
+#define TR_SF_SCREEN_RECORD            "Optag skærm"
 #define TR_SF_RESERVE                  "[reserve]"
 
 #define TR_FSW_RESET_TELEM             TR("Telm", "Telemetri")
@@ -413,7 +414,9 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_MIXER_LATE                  "Mix late"
 #define TR_FREE_STACK                  "Fri stak"
+#define TR_CPU_LOAD                    "CPU load"
 #define TR_INT_GPS_LABEL               "Intern GPS"
 #define TR_HEARTBEAT_LABEL             "Hjerte puls"
 #define TR_LUA_SCRIPTS_LABEL           "Lua script"
@@ -1121,6 +1124,7 @@
 #define TR_MENU_INVERT                 "Invers"
 #define TR_AUDIO_MUTE                  TR("Audio fra","Audio fra, hvis der ikke gives lyd")
 #define TR_JITTER_FILTER               "ADC filter"
+#define TR_MIXER_DEFER                 TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE                   "Dødt område"
 #define TR_RTC_CHECK                   TR("Check RTC", "Check RTC spænding")
 #define TR_AUTH_FAILURE                "Godkendelse fejlet"
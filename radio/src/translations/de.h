@@ -121,6 +121,7 @@
 #define TR_SF_RACING_MODE              "RacingMode"
 #define TR_SF_DISABLE_TOUCH            "Kein Touch"
 #define TR_SF_SET_SCREEN               "Set Main Screen"
+#define TR_SF_SCREEN_RECORD            "Screen Record"
 
 #define TR_FSW_RESET_TELEM             TR("Telm","Telemetrie")
 
@@ -409,7 +410,9 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS         	       "Tmix max"
+#define TR_MIXER_LATE                  "Mix spät"
 #define TR_FREE_STACK     		       "Freier Stack"
+#define TR_CPU_LOAD       		       "CPU-Last"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua scripts"
@@ -1111,6 +1114,7 @@
 #define TR_MENU_INVERT                 "Invertieren<!>"
 #define TR_AUDIO_MUTE                  TR("Ton Stumm","Geräuschunterdrückung")
 #define TR_JITTER_FILTER               "ADC Filter"
+#define TR_MIXER_DEFER                 TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE                   "Dead zone"
 #define TR_RTC_CHECK                   TR("RTC Prüfen", "RTC Spann. prüfen")
 #define TR_AUTH_FAILURE                "Auth-Fehler"
@@ -119,6 +119,7 @@
 #define TR_SF_RACING_MODE     "RacingMode"
 #define TR_SF_DISABLE_TOUCH   "No Touch"
 #define TR_SF_SET_SCREEN      "Set Main Screen"
+#define TR_SF_SCREEN_RECORD   "Screen Record"
 
 #define TR_FSW_RESET_TELEM     TR("Telm", "Telemetría")
 
@@ -400,7 +401,9 @@
 #define TR_US                         "us"
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "Tmix máx"
+#define TR_MIXER_LATE                 "Mix tarde"
 #define TR_FREE_STACK                 "Stack libre"
+#define TR_CPU_LOAD                   "Carga CPU"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL          "Lua scripts"
@@ -1114,6 +1117,7 @@
 #define TR_MENU_INVERT         "Invertir"
 #define TR_AUDIO_MUTE                  TR("Audio mute","Mute if no sound")
 #define TR_JITTER_FILTER       "Filtro ADC"
+#define TR_MIXER_DEFER         TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE           "Dead zone"
 #define TR_RTC_CHECK           TR("Check RTC", "Check RTC voltaje")
 #define TR_AUTH_FAILURE        "Fallo " LCDW_128_480_LINEBREAK  "autentificación"
@@ -121,6 +121,7 @@
 #define TR_SF_RACING_MODE              "Racing Mode"
 #define TR_SF_DISABLE_TOUCH            "Non Tactile"
 #define TR_SF_SET_SCREEN               "Définir Écran Princ."
+#define TR_SF_SCREEN_RECORD            "Enreg. Écran"
 
 #define TR_FSW_RESET_TELEM             TR("Télem.", "Télémétrie")
 
@@ -416,7 +417,9 @@
 #define TR_HZ                          "Hz"
 
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_MIXER_LATE                  "Mix retard"
 #define TR_FREE_STACK                  "Pile libre"
+#define TR_CPU_LOAD                    "Charge CPU"
 #define TR_INT_GPS_LABEL               "GPS interne"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua scripts"
@@ -1127,6 +1130,7 @@
 #define TR_MENU_INVERT                 "Inverser"
 #define TR_AUDIO_MUTE                  TR("Audio muet","Muet si pas de son")
 #define TR_JITTER_FILTER               "Filtre ADC"
+#define TR_MIXER_DEFER                 TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE                   "Zone Neutre"
 #define TR_RTC_CHECK                   TR("Vérif. RTC", "Vérif. pile RTC")
 #define TR_AUTH_FAILURE                "Échec authentification"
@@ -122,6 +122,7 @@
 #define TR_SF_RACING_MODE              "Modo Racing"
 #define TR_SF_DISABLE_TOUCH            "No Touch"
 #define TR_SF_SET_SCREEN               "Setta Schermo Princ."
+#define TR_SF_SCREEN_RECORD            "Registra Schermo"
 
 #define TR_FSW_RESET_TELEM               TR("Telm", "Telemetria")
 
@@ -407,7 +408,9 @@
 #define TR_US                           "us"
 #define TR_HZ                           "Hz"
 #define TR_TMIXMAXMS                    "Tmix max"
+#define TR_MIXER_LATE                   "Mix ritardo"
 #define TR_FREE_STACK                   "Stack libero"
+#define TR_CPU_LOAD                     "Carico CPU"
 #define TR_INT_GPS_LABEL                "GPS interno"
 #define TR_HEARTBEAT_LABEL              "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL            "Lua scripts"
@@ -1108,6 +1111,7 @@
 #define TR_MENU_INVERT                  "Inverti"
 #define TR_AUDIO_MUTE                   TR("Audio muto","Muto senza suono")
 #define TR_JITTER_FILTER                "Filtro ADC"
+#define TR_MIXER_DEFER                  TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE                    "Zona morta"
 #define TR_RTC_CHECK                    TR("Controllo RTC", "Controllo volt. RTC")
 #define TR_AUTH_FAILURE                 "Fallimento Auth"
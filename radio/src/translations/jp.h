@@ -117,6 +117,7 @@
 #define TR_SF_RACING_MODE              "レースモード"
 #define TR_SF_DISABLE_TOUCH            "非タッチ"
 #define TR_SF_SET_SCREEN               "メインスクリーン設定"
+#define TR_SF_SCREEN_RECORD            "画面録画"
 #define TR_SF_RESERVE                  "[予備]"
 
 #define TR_FSW_RESET_TELEM             TR("Telm", "テレメトリー")
@@ -404,7 +405,9 @@
 #define TR_US                          "us"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_MIXER_LATE                  "Mix late"
 #define TR_FREE_STACK                  "Free stack"
+#define TR_CPU_LOAD                    "CPU load"
 #define TR_INT_GPS_LABEL               "内蔵GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL           "Lua scripts"
@@ -1106,6 +1109,7 @@
 #define TR_MENU_INVERT                 "リバース"
 #define TR_AUDIO_MUTE                  TR("Audio mute","Mute if no sound")
 #define TR_JITTER_FILTER               "ADCフィルター"
+#define TR_MIXER_DEFER                 TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE                   "デッドゾーン"
 #define TR_RTC_CHECK                   TR("Check RTC", "内蔵電池チェック")
 #define TR_AUTH_FAILURE                "検証失敗"
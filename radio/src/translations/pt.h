@@ -118,6 +118,7 @@
 #define TR_SF_RACING_MODE     "RacingMode"
 #define TR_SF_DISABLE_TOUCH   "No Touch"
 #define TR_SF_SET_SCREEN      "Set Main Screen"
+#define TR_SF_SCREEN_RECORD   "Screen Record"
 
 #define TR_FSW_RESET_TELEM     TR("Telm", "Telemetry")
 
@@ -404,7 +405,9 @@
 #define TR_US                         "us"
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "Tmix max"
+#define TR_MIXER_LATE                 "Mix late"
 #define TR_FREE_STACK                 "Free stack"
+#define TR_CPU_LOAD                   "CPU load"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL          "Lua scripts"
@@ -1116,6 +1119,7 @@
 #define TR_MENU_INVERT         "Invert"
 #define TR_AUDIO_MUTE                  TR("Audio mute","Mute if no sound")
 #define TR_JITTER_FILTER       "ADC Filter"
+#define TR_MIXER_DEFER         TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE           "Dead zone"
 #define TR_RTC_CHECK           TR("Check RTC", "Check RTC voltage")
 #define TR_AUTH_FAILURE        "Auth-failure"
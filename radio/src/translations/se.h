@@ -128,6 +128,7 @@
 #define TR_SF_RACING_MODE               "Tävlingsläge"
 #define TR_SF_DISABLE_TOUCH             "Ej pekskärm"
 #define TR_SF_SET_SCREEN                "Sätt huvudskärm"
+#define TR_SF_SCREEN_RECORD             "Spela in skärm"
 #define TR_SF_RESERVE                   "[reserv]"
 
 #define TR_FSW_RESET_TELEM              TR("Telm","Telemetri")
@@ -431,7 +432,9 @@
 #define TR_HZ                           "Hz"
 
 #define TR_TMIXMAXMS                    "Tmix max"
+#define TR_MIXER_LATE                   "Mix sen"
 #define TR_FREE_STACK                   "Fri stack"
+#define TR_CPU_LOAD                     "CPU load"
 #define TR_INT_GPS_LABEL                "Intern GPS"
 #define TR_HEARTBEAT_LABEL              "Heartbeat"
 #define TR_LUA_SCRIPTS_LABEL            "Lua-skript"
@@ -1148,6 +1151,7 @@
 #define TR_MENU_INVERT                  "Invertera"
 #define TR_AUDIO_MUTE                   TR("Audio av","Audio av om inget ljud")
 #define TR_JITTER_FILTER                "ADC-filter"
+#define TR_MIXER_DEFER                  TR("Defer late mixer", "Defer updates on late mixer")
 #define TR_DEAD_ZONE                    "Dödläge"
 #define TR_RTC_CHECK                    TR("Kolla RTC", "Kolla RTC-batteriet")
 #define TR_AUTH_FAILURE                 "Auth-failure"
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+"""
+    Converts a screen recording made with the "Screen Record" special function
+    (/SCREENSHOTS/record-*.rec on the SD card) into an animated GIF, or into
+    a sequence of PNG frames which can be turned into a video with ffmpeg.
+
+    Usage:
+
+        ./screenrec2gif.py record-2023-01-01-123540.rec out.gif
+        ./screenrec2gif.py --png frames record-2023-01-01-123540.rec
+        ffmpeg -framerate 10 -i frames/%05d.png out.mp4
+
+    Requires Pillow (pip install Pillow).
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+from PIL import Image
+
+MAGIC = b"EREC"
+VERSION = 1
+
+
+def rgb565(value):
+    r = (value >> 11) & 0x1F
+    g = (value >> 5) & 0x3F
+    b = value & 0x1F
+    return (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)
+
+
+def read(f, fmt):
+    size = struct.calcsize(fmt)
+    data = f.read(size)
+    if len(data) < size:
+        raise EOFError()
+    return struct.unpack(fmt, data)
+
+
+def frames(f):
+    """Yields (time_ms, image) for each complete frame of the recording"""
+    magic, version, width, height = read(f, "<4sHHH")
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not a screen recording (version %d)" % VERSION)
+
+    image = Image.new("RGB", (width, height))
+    pixels = image.load()
+    while True:
+        try:
+            time, rows = read(f, "<IH")
+            for _ in range(rows):
+                y, x, length = read(f, "<HHH")
+                for i, value in enumerate(read(f, "<%dH" % length)):
+                    pixels[x + i, y] = rgb565(value)
+        except EOFError:
+            # the recording may end with a truncated frame (power off)
+            return
+        yield time, image.copy()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a screen recording")
+    parser.add_argument("--png", metavar="DIR", help="write PNG frames into DIR instead of a GIF")
+    parser.add_argument("input", help="recording (.rec)")
+    parser.add_argument("output", nargs="?", help="animated GIF")
+    args = parser.parse_args()
+
+    if not args.png and not args.output:
+        parser.error("an output GIF or --png DIR is required")
+
+    with open(args.input, "rb") as f:
+        recording = list(frames(f))
+
+    if not recording:
+        print("No frame in %s" % args.input, file=sys.stderr)
+        return 1
+
+    if args.png:
+        os.makedirs(args.png, exist_ok=True)
+        for index, (_, image) in enumerate(recording):
+            image.save(os.path.join(args.png, "%05d.png" % index))
+        return 0
+
+    times = [time for time, _ in recording]
+    durations = [max(10, b - a) for a, b in zip(times, times[1:])] + [100]
+    images = [image for _, image in recording]
+    images[0].save(args.output, save_all=True, append_images=images[1:],
+                   duration=durations, loop=0)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+"""
+    This script converts a trace buffer dump (firmware or simulator built with
+    DEBUG_TRACE_BUFFER) into the Chrome trace event format, which can be opened
+    with chrome://tracing or https://ui.perfetto.dev
+
+    The dump is obtained with "print trace" on the CLI, "print trace save"
+    (written to /LOGS/trace.txt on the SD card), or with a long press on ENTER
+    in the trace buffer screen (written to the debug output).
+
+    Usage:
+
+        ./radio/util/trace2json.py trace.txt > trace.json
+"""
+
+import json
+import os
+import re
+import sys
+
+HEADER = re.compile(r"trace buffer: (\d+) ticks/us")
+ELEMENT = re.compile(r"(\d+),(.),(\d+),0x([0-9a-fA-F]+)")
+FOOTER = "trace end"
+
+DEBUG_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "debug.h")
+
+
+def read_event_names(filename):
+    """ Event names, taken from 'enum TraceEvent' in debug.h """
+    names = {}
+    with open(filename) as f:
+        text = f.read()
+    match = re.search(r"enum TraceEvent\s*{(.*?)}", text, re.DOTALL)
+    if not match:
+        return names
+    value = -1
+    for line in match.group(1).splitlines():
+        line = line.split("//")[0].strip().rstrip(",")
+        if not line:
+            continue
+        if "=" in line:
+            name, value = [x.strip() for x in line.split("=")]
+            value = int(value, 0)
+        else:
+            name = line
+            value += 1
+        names[value] = name
+    return names
+
+
+def convert(inp, names):
+    events = []
+    ticks_per_us = None
+    last = None
+    now = 0
+
+    for line in inp:
+        line = line.strip()
+
+        match = HEADER.search(line)
+        if match:
+            ticks_per_us = int(match.group(1))
+            last = None
+            now = 0
+            continue
+
+        if ticks_per_us is None:
+            continue
+
+        if line.endswith(FOOTER):
+            ticks_per_us = None
+            continue
+
+        match = ELEMENT.search(line)
+        if not match:
+            continue
+
+        time, kind, event, data = match.groups()
+        time = int(time)
+        if last is not None:
+            # the counter wraps around, and concurrent writers may
+            # record their elements slightly out of order
+            delta = (time - last) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            now += delta
+        last = time
+
+        name = names.get(int(event), "event %s" % event)
+        element = {
+            "name": name,
+            "ph": kind,
+            "ts": now / ticks_per_us,
+            "pid": 1,
+            "tid": name if kind != "i" else "events",
+        }
+        if kind == "i":
+            element["s"] = "t"
+            element["args"] = {"data": "0x" + data}
+        events.append(element)
+
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    inp = open(sys.argv[1], "r") if len(sys.argv) > 1 else sys.stdin
+    names = read_event_names(DEBUG_H) if os.path.exists(DEBUG_H) else {}
+    json.dump(convert(inp, names), sys.stdout, indent=1)
+    print()
+
+
+if __name__ == "__main__":
+    main()